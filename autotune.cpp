@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <complex>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "dft_versions.h"
+#include "autotune.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_BLUE "\033[34m"
+#define COLOR_GREEN "\033[32m"
+
+// Above this length, the O(N²) versions (sequential V1, parallel V0) are not timed
+const int TUNE_QUADRATIC_MAX = 4096;
+const int TUNE_REPETITIONS = 7;
+const double TUNE_MIN_SAMPLE_SECONDS = 1e-4;
+// A candidate whose first call is this many times slower than the best one so far is not timed further
+const double TUNE_PRUNE_FACTOR = 20.0;
+
+// Measured plans, keyed by (N, parallel allowed)
+static std::map<std::pair<int, bool>, TunedPlan> wisdom;
+static std::mutex wisdom_mutex;
+
+
+/**
+ * @brief Returns the wisdom file name: $FFT_WISDOM, or fft_wisdom.txt in the working directory.
+ */
+std::string defaultWisdomPath() {
+    const char* env = std::getenv("FFT_WISDOM");
+    return env != nullptr && *env != '\0' ? env : "fft_wisdom.txt";
+}
+
+
+/**
+ * @brief Adds the plans of a wisdom file to the ones in memory (a missing file is not an error
+ * for the caller: it returns false and nothing changes).
+ *
+ * Each line holds "<N> <sequential|parallel> <sequential|parallel> <version> <threads> <seconds>":
+ * the size, the modes the plan was tuned for, then the mode, version and thread count of the plan.
+ * Lines starting with '#' are comments.
+ */
+bool loadWisdom(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(wisdom_mutex);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        int N;
+        std::string allowed, mode;
+        TunedPlan plan;
+        if (fields >> N >> allowed >> mode >> plan.version >> plan.threads >> plan.seconds) {
+            plan.parallel = mode == "parallel";
+            if (N > 0 && plan.threads > 0 && isValidVersion(plan.parallel, plan.version) && plan.version != AUTO_VERSION) {
+                wisdom[{N, allowed == "parallel"}] = plan;
+            }
+        }
+    }
+    return true;
+}
+
+
+/**
+ * @brief Writes every plan in memory to a wisdom file (see loadWisdom for the format).
+ */
+bool saveWisdom(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(wisdom_mutex);
+    file << "# FFT wisdom: <N> <modes tuned for> <mode> <version> <threads> <median seconds>\n";
+    for (const auto& entry : wisdom) {
+        const TunedPlan& plan = entry.second;
+        file << entry.first.first << " " << (entry.first.second ? "parallel" : "sequential") << " "
+             << (plan.parallel ? "parallel" : "sequential") << " " << plan.version << " " << plan.threads << " " << plan.seconds << "\n";
+    }
+    return (bool) file;
+}
+
+
+/**
+ * @brief Plan used for a size without wisdom: the radix-4 (or mixed-radix) sequential version,
+ * and the parallel six-step (or mixed-radix) version on every thread for large sizes.
+ */
+static TunedPlan defaultPlan(int N, bool allow_parallel) {
+    if (allow_parallel && N >= (1 << 16)) {
+        return {true, isPowerOfTwo(N) ? 4 : 3, getThreadPool().maxSize(), 0.0};
+    }
+    return {false, isPowerOfTwo(N) ? 6 : 4, 1, 0.0};
+}
+
+
+bool hasWisdom(int N, bool allow_parallel) {
+    std::lock_guard<std::mutex> lock(wisdom_mutex);
+    return wisdom.count({N, allow_parallel}) > 0;
+}
+
+
+/**
+ * @brief Returns the measured plan for N, or the default plan if N has not been tuned.
+ */
+TunedPlan choosePlan(int N, bool allow_parallel) {
+    {
+        std::lock_guard<std::mutex> lock(wisdom_mutex);
+        auto it = wisdom.find({N, allow_parallel});
+        if (it != wisdom.end()) {
+            return it->second;
+        }
+    }
+    return defaultPlan(N, allow_parallel);
+}
+
+
+/**
+ * @brief Returns e.g. "parallel V4 on 4 threads" or "sequential V6".
+ */
+std::string planDescription(const TunedPlan& plan) {
+    std::string description = std::string(plan.parallel ? "parallel" : "sequential") + " V" + std::to_string(plan.version);
+    if (plan.parallel) {
+        description += " on " + std::to_string(plan.threads) + (plan.threads == 1 ? " thread" : " threads");
+    }
+    return description;
+}
+
+
+/**
+ * @brief Runs a transform of the plan's mode and version with the plan's thread count.
+ *
+ * The thread count limits the active threads of the shared pool (which also fixes the number
+ * of leaf blocks of V1/V2) for the duration of the call. Inside a pool task, the transform
+ * runs inline anyway, so the pool is not touched.
+ */
+static void runPlan(std::vector<std::complex<double>>& data, const TunedPlan& plan, bool inverse) {
+    bool limit_threads = plan.parallel && !insidePoolTask();
+    ThreadPool& pool = getThreadPool();
+    int previous_threads = pool.size();
+
+    if (limit_threads) {
+        pool.setActiveThreads(plan.threads);
+    }
+
+    if (inverse) {
+        inverseDFT(data, plan.parallel, plan.version);
+    } else {
+        forwardDFT(data, plan.parallel, plan.version);
+    }
+
+    if (limit_threads) {
+        pool.setActiveThreads(previous_threads);
+    }
+}
+
+
+/**
+ * @brief Runs the fastest measured plan for data.size() (the "auto" version).
+ *
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param allow_parallel False to only use sequential plans (sequential mode).
+ * @param inverse True for the inverse transform.
+ */
+void autoDFT(std::vector<std::complex<double>>& data, bool allow_parallel, bool inverse) {
+    runPlan(data, choosePlan(data.size(), allow_parallel), inverse);
+}
+
+
+/**
+ * @brief Tells whether a candidate is an O(N²) version and N is above TUNE_QUADRATIC_MAX.
+ */
+static bool tooSlowToTune(int N, const TunedPlan& plan) {
+    if (!plan.parallel) {
+        return plan.version == 1 && N > TUNE_QUADRATIC_MAX;
+    }
+    return plan.version == 0 && N > TUNE_QUADRATIC_MAX;
+}
+
+
+/**
+ * @brief Measures the median time of a forward transform of input with a plan.
+ *
+ * Each sample repeats the transform (from a fresh copy of the input) until it lasts
+ * TUNE_MIN_SAMPLE_SECONDS, so that small sizes are above the clock resolution.
+ *
+ * @return The median time, or a negative value if the first call exceeded first_call_limit.
+ */
+static double timePlan(const std::vector<std::complex<double>>& input, const TunedPlan& plan, double first_call_limit) {
+    std::vector<std::complex<double>> work(input.size());
+
+    auto run = [&](int calls) {
+        auto start = std::chrono::steady_clock::now();
+        for (int c = 0; c < calls; c++) {
+            work = input;
+            runPlan(work, plan, false);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    };
+
+    // The first call also builds the cached plans
+    if (run(1) > first_call_limit) {
+        return -1.0;
+    }
+    int calls = 1;
+    while (calls < (1 << 20) && run(calls) < TUNE_MIN_SAMPLE_SECONDS) {
+        calls *= 2;
+    }
+
+    std::vector<double> times;
+    for (int r = 0; r < TUNE_REPETITIONS; r++) {
+        times.push_back(run(calls) / calls);
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+
+/**
+ * @brief Times every candidate configuration for N on this machine and records the fastest one.
+ *
+ * The candidates are every version that handles N natively (non power-of-2 sizes only get the
+ * mixed-radix versions) and, if allowed, every parallel version with 1, 2, 4, ... threads up to
+ * the pool size; for V1/V2 the thread count also fixes the number and length of the leaves.
+ *
+ * @param N Size of the transform.
+ * @param allow_parallel False to only consider sequential versions.
+ * @return The fastest plan, also stored in the wisdom.
+ */
+TunedPlan tuneSize(int N, bool allow_parallel) {
+    std::vector<TunedPlan> candidates;
+    for (int version = 1; isValidVersion(false, version); version++) {
+        if (resolveVersion(N, false, version) == version) {
+            candidates.push_back({false, version, 1, 0.0});
+        }
+    }
+    if (allow_parallel) {
+        int max_threads = getThreadPool().maxSize();
+        std::vector<int> thread_counts;
+        for (int threads = 1; threads < max_threads; threads *= 2) {
+            thread_counts.push_back(threads);
+        }
+        thread_counts.push_back(max_threads);
+
+        for (int version = 0; isValidVersion(true, version); version++) {
+            if (resolveVersion(N, true, version) == version) {
+                for (int threads : thread_counts) {
+                    candidates.push_back({true, version, threads, 0.0});
+                }
+            }
+        }
+    }
+
+    std::mt19937 generator(N);
+    std::normal_distribution<double> distribution;
+    std::vector<std::complex<double>> input(N);
+    for (auto& value : input) {
+        value = std::complex<double>(distribution(generator), distribution(generator));
+    }
+
+    TunedPlan best = defaultPlan(N, allow_parallel);
+    best.seconds = -1.0;
+    for (TunedPlan& candidate : candidates) {
+        if (tooSlowToTune(N, candidate)) {
+            continue;
+        }
+        double limit = best.seconds > 0 ? std::max(TUNE_PRUNE_FACTOR * best.seconds, 1e-3) : 1e9;
+        candidate.seconds = timePlan(input, candidate, limit);
+        if (candidate.seconds > 0 && (best.seconds < 0 || candidate.seconds < best.seconds)) {
+            best = candidate;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(wisdom_mutex);
+    wisdom[{N, allow_parallel}] = best;
+    return best;
+}
+
+
+/**
+ * @brief Tunes each size, prints the chosen plans and saves the wisdom file.
+ *
+ * @param sizes Sizes to tune.
+ * @param allow_parallel False to only consider sequential versions.
+ * @param filename Wisdom file to update.
+ */
+void autotune(const std::vector<int>& sizes, bool allow_parallel, const std::string& filename) {
+    std::string label = COLOR_BLUE "[Auto-tune] " COLOR_RESET;
+
+    for (int N : sizes) {
+        TunedPlan plan = tuneSize(N, allow_parallel);
+        std::cout << label << "N = " << N << ": " << planDescription(plan) << ", " << COLOR_GREEN << plan.seconds << " seconds" << COLOR_RESET << std::endl;
+    }
+
+    if (saveWisdom(filename)) {
+        std::cout << label << "Wisdom saved to " << filename << std::endl;
+    } else {
+        std::cerr << "Could not write the wisdom file " << filename << std::endl;
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include <complex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Configuration used for one size by the "auto" version: engine (mode and version) and thread count.
+ */
+struct TunedPlan {
+    bool parallel;
+    int version;
+    int threads;
+    double seconds; // median time of a forward transform when measured, 0 for the default plan
+};
+
+std::string defaultWisdomPath();
+bool loadWisdom(const std::string& filename);
+bool saveWisdom(const std::string& filename);
+TunedPlan tuneSize(int N, bool allow_parallel);
+TunedPlan choosePlan(int N, bool allow_parallel);
+bool hasWisdom(int N, bool allow_parallel);
+std::string planDescription(const TunedPlan& plan);
+void autoDFT(std::vector<std::complex<double>>& data, bool allow_parallel, bool inverse);
+void autotune(const std::vector<int>& sizes, bool allow_parallel, const std::string& filename);
+
+#endif
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <complex>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/fft_plan.h"
+#include "core/thread_pool.h"
+
+#include "batch_dft.h"
+#include "dft_versions.h"
+#include "full_dft.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_BLUE "\033[34m"
+#define COLOR_ORANGE "\033[38;5;214m"
+#define COLOR_GREEN "\033[32m"
+
+// Signals at least this long are transformed one after the other with the parallel six-step
+// engine when there are fewer signals than threads; otherwise each thread takes whole signals
+const int BATCH_WITHIN_SIGNAL_MIN_LENGTH = 1 << 16;
+
+// Number of signals gathered together when the layout is not contiguous, so that the reads of
+// an interleaved batch use whole cache lines
+const int BATCH_GATHER_TILE = 8;
+
+
+/**
+ * @brief Layout of signals stored one after the other: signal i occupies [i * length, (i + 1) * length).
+ */
+BatchLayout stridedLayout(int count, int length) {
+    return BatchLayout{count, length, length, 1};
+}
+
+
+/**
+ * @brief Layout of interleaved signals: sample j of every signal is stored together, at [j * count, (j + 1) * count).
+ */
+BatchLayout interleavedLayout(int count, int length) {
+    return BatchLayout{count, length, 1, count};
+}
+
+
+/**
+ * @brief Transforms the signals [first, last) of a batch on the calling thread.
+ *
+ * Contiguous signals are transformed in place with the shared plan. Otherwise up to
+ * BATCH_GATHER_TILE signals are copied to a per-thread buffer, transformed and copied back.
+ */
+template <typename T>
+static void transformSignals(std::complex<T>* data, const BatchLayout& layout, bool inverse, const FFTPlanT<T>* plan, int first, int last) {
+    int length = layout.length;
+
+    if (plan != nullptr && layout.element_stride == 1) {
+        for (int i = first; i < last; i++) {
+            executePlan(*plan, data + (size_t)i * layout.signal_stride);
+        }
+        return;
+    }
+
+    thread_local std::vector<std::complex<T>> buffer;
+    thread_local std::vector<std::complex<T>> signal;
+    for (int tile = first; tile < last; tile += BATCH_GATHER_TILE) {
+        int width = std::min(BATCH_GATHER_TILE, last - tile);
+        buffer.resize((size_t)width * length);
+
+        for (int j = 0; j < length; j++) {
+            const std::complex<T>* row = data + (size_t)j * layout.element_stride + (size_t)tile * layout.signal_stride;
+            for (int s = 0; s < width; s++) {
+                buffer[(size_t)s * length + j] = row[(size_t)s * layout.signal_stride];
+            }
+        }
+
+        for (int s = 0; s < width; s++) {
+            if (plan != nullptr) {
+                executePlan(*plan, buffer.data() + (size_t)s * length);
+            } else {
+                // Sizes that are not a power of 2 go through the sequential mixed-radix version
+                signal.assign(buffer.begin() + (size_t)s * length, buffer.begin() + (size_t)(s + 1) * length);
+                if (inverse) {
+                    inverseDFT(signal, false, 4);
+                } else {
+                    forwardDFT(signal, false, 4);
+                }
+                std::copy(signal.begin(), signal.end(), buffer.begin() + (size_t)s * length);
+            }
+        }
+
+        for (int j = 0; j < length; j++) {
+            std::complex<T>* row = data + (size_t)j * layout.element_stride + (size_t)tile * layout.signal_stride;
+            for (int s = 0; s < width; s++) {
+                row[(size_t)s * layout.signal_stride] = buffer[(size_t)s * length + j];
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief Computes the DFT (or inverse DFT) of every signal of a batch in place.
+ *
+ * One plan is shared by the whole batch. When there are at least as many signals as threads,
+ * or the signals are short, the signals are shared out over the thread pool and each one is
+ * transformed sequentially. A few long signals are instead transformed one by one with the
+ * parallel six-step version (parallel mixed radix when the length is not a power of 2).
+ *
+ * @param data Pointer to the first sample of the batch.
+ * @param layout Number of signals, length and strides (see stridedLayout / interleavedLayout).
+ * @param inverse True for the inverse DFT.
+ */
+template <typename T>
+void batchDFT(std::complex<T>* data, const BatchLayout& layout, bool inverse) {
+    if (layout.count <= 0 || layout.length <= 1) {
+        return;
+    }
+
+    ThreadPool& pool = getThreadPool();
+
+    if (layout.count < pool.size() && layout.length >= BATCH_WITHIN_SIGNAL_MIN_LENGTH) {
+        int version = isPowerOfTwo(layout.length) ? 4 : 3;
+        std::vector<std::complex<T>> signal(layout.length);
+        for (int i = 0; i < layout.count; i++) {
+            std::complex<T>* start = data + (size_t)i * layout.signal_stride;
+            for (int j = 0; j < layout.length; j++) {
+                signal[j] = start[(size_t)j * layout.element_stride];
+            }
+            if (inverse) {
+                inverseDFT(signal, true, version);
+            } else {
+                forwardDFT(signal, true, version);
+            }
+            for (int j = 0; j < layout.length; j++) {
+                start[(size_t)j * layout.element_stride] = signal[j];
+            }
+        }
+        return;
+    }
+
+    const FFTPlanT<T>* plan = nullptr;
+    if (isPowerOfTwo(layout.length)) {
+        plan = &getPlan<T>(layout.length, inverse, 1, FFTAlgorithm::Radix4);
+    }
+
+    pool.parallel_for(0, layout.count, [&](int first, int last) {
+        transformSignals(data, layout, inverse, plan, first, last);
+    });
+}
+
+
+/**
+ * @brief Computes the DFT (or inverse DFT) of every signal of a batch stored in a vector.
+ */
+template <typename T>
+void batchDFT(std::vector<std::complex<T>>& data, const BatchLayout& layout, bool inverse) {
+    batchDFT(data.data(), layout, inverse);
+}
+
+
+/**
+ * @brief Compares one batched transform of a set of equal-length series with one transform per series.
+ *
+ * The series are packed both one after the other and interleaved; the time of each batched
+ * transform is printed along with its error against the per-series results. The version only
+ * applies to the reference: the batched transforms always run the batch engine, on the whole
+ * pool in parallel mode and on one thread in sequential mode.
+ *
+ * @param series Input series, all of the same length.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm used for the per-series reference.
+ */
+void batch_dft(const std::vector<std::vector<std::complex<double>>>& series, bool parallel, int version) {
+    if (series.empty()) {
+        std::cerr << "No series to transform" << std::endl;
+        return;
+    }
+
+    int count = series.size();
+    int length = series[0].size();
+    version = resolveVersion(length, parallel, version);
+    std::string label = versionLabel(parallel, version);
+
+    std::vector<std::complex<double>> reference;
+    reference.reserve((size_t)count * length);
+    auto start1 = std::chrono::high_resolution_clock::now();
+    for (const auto& signal : series) {
+        std::vector<std::complex<double>> copy = signal;
+        forwardDFT(copy, parallel, version);
+        reference.insert(reference.end(), copy.begin(), copy.end());
+    }
+    auto end1 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration1 = end1 - start1;
+    std::cout << label << "Time taken for " << count << " separate DFTs of " << length << " points: " << COLOR_GREEN << duration1.count() << " seconds" << COLOR_RESET << std::endl;
+
+    // In sequential mode the batch engine runs on the calling thread only
+    ThreadPool& pool = getThreadPool();
+    int previous_threads = pool.size();
+    if (!parallel) {
+        pool.setActiveThreads(1);
+    }
+    std::string batch_label = COLOR_BLUE "[Batch] " COLOR_RESET;
+    std::string threads = std::to_string(pool.size()) + (pool.size() == 1 ? " thread" : " threads");
+
+    BatchLayout strided = stridedLayout(count, length);
+    std::vector<std::complex<double>> batch;
+    batch.reserve((size_t)count * length);
+    for (const auto& signal : series) {
+        batch.insert(batch.end(), signal.begin(), signal.end());
+    }
+    auto start2 = std::chrono::high_resolution_clock::now();
+    batchDFT(batch, strided, false);
+    auto end2 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration2 = end2 - start2;
+    std::cout << batch_label << "Time taken for the batched DFT (strided, " << threads << "): " << COLOR_GREEN << duration2.count() << " seconds" << COLOR_RESET
+              << ", error: " << COLOR_ORANGE << computeAbsoluteError(reference, batch) << COLOR_RESET << std::endl;
+
+    BatchLayout interleaved = interleavedLayout(count, length);
+    std::vector<std::complex<double>> packed((size_t)count * length);
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < length; j++) {
+            packed[(size_t)j * count + i] = series[i][j];
+        }
+    }
+    auto start3 = std::chrono::high_resolution_clock::now();
+    batchDFT(packed, interleaved, false);
+    auto end3 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration3 = end3 - start3;
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < length; j++) {
+            batch[(size_t)i * length + j] = packed[(size_t)j * count + i];
+        }
+    }
+    std::cout << batch_label << "Time taken for the batched DFT (interleaved, " << threads << "): " << COLOR_GREEN << duration3.count() << " seconds" << COLOR_RESET
+              << ", error: " << COLOR_ORANGE << computeAbsoluteError(reference, batch) << COLOR_RESET << std::endl;
+
+    pool.setActiveThreads(previous_threads);
+}
+
+
+template void batchDFT<float>(std::complex<float>* data, const BatchLayout& layout, bool inverse);
+template void batchDFT<double>(std::complex<double>* data, const BatchLayout& layout, bool inverse);
+template void batchDFT<float>(std::vector<std::complex<float>>& data, const BatchLayout& layout, bool inverse);
+template void batchDFT<double>(std::vector<std::complex<double>>& data, const BatchLayout& layout, bool inverse);
@@ -0,0 +1,30 @@
+#ifndef BATCH_DFT_H
+#define BATCH_DFT_H
+
+#include <complex>
+#include <vector>
+
+/**
+ * @brief Memory layout of a batch of count signals of the same length.
+ *
+ * Sample j of signal i is stored at i * signal_stride + j * element_stride.
+ */
+struct BatchLayout {
+    int count;
+    int length;
+    int signal_stride;
+    int element_stride;
+};
+
+BatchLayout stridedLayout(int count, int length);
+BatchLayout interleavedLayout(int count, int length);
+
+// Instantiated for float and double
+template <typename T>
+void batchDFT(std::complex<T>* data, const BatchLayout& layout, bool inverse);
+template <typename T>
+void batchDFT(std::vector<std::complex<T>>& data, const BatchLayout& layout, bool inverse);
+
+void batch_dft(const std::vector<std::vector<std::complex<double>>>& series, bool parallel, int version);
+
+#endif
@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../core/simd_kernels.h"
+#include "../core/thread_pool.h"
+#include "../dft_versions.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_BLUE "\033[34m"
+#define COLOR_GREEN "\033[32m"
+
+int p = 1; // number of processors, set for each thread count of the sweep
+
+
+/**
+ * @brief Options of a benchmark run, read from the command line.
+ */
+struct BenchmarkOptions {
+    int min_log = 3;
+    int max_log = 24;
+    std::vector<int> threads = {1, 2, 4};
+    std::vector<int> sequential_versions = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<int> parallel_versions = {0, 1, 2, 3, 4};
+    int warmup = 2;
+    int repetitions = 11;
+    double min_sample_seconds = 1e-4;
+    double max_case_seconds = 1.0;
+    std::string csv_file = "benchmark.csv";
+    std::string json_file = "benchmark.json";
+};
+
+
+/**
+ * @brief Statistics of one (mode, version, threads, N) case.
+ */
+struct BenchmarkResult {
+    std::string mode;
+    int version;
+    int threads;
+    int N;
+    int repetitions;
+    double median;
+    double p10;
+    double p90;
+    double min;
+    double gflops;
+    bool has_baseline; // false when sequential V2 was not timed at this N (speedup and efficiency unknown)
+    double speedup;
+    double efficiency;
+};
+
+
+static std::vector<int> parseList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(std::stoi(item));
+        }
+    }
+    return values;
+}
+
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--min-log <k>] [--max-log <k>] [--threads <t1,t2,...>]"
+              << " [--sequential <v1,v2,...>] [--parallel <v1,v2,...>] [--warmup <n>] [--repetitions <n>]"
+              << " [--max-case-seconds <s>] [--csv <file>] [--json <file>]" << std::endl;
+}
+
+
+static bool parseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (flag == "--min-log") {
+            options.min_log = std::stoi(value);
+        } else if (flag == "--max-log") {
+            options.max_log = std::stoi(value);
+        } else if (flag == "--threads") {
+            options.threads = parseList(value);
+        } else if (flag == "--sequential") {
+            options.sequential_versions = parseList(value);
+        } else if (flag == "--parallel") {
+            options.parallel_versions = parseList(value);
+        } else if (flag == "--warmup") {
+            options.warmup = std::stoi(value);
+        } else if (flag == "--repetitions") {
+            options.repetitions = std::stoi(value);
+        } else if (flag == "--max-case-seconds") {
+            options.max_case_seconds = std::stod(value);
+        } else if (flag == "--csv") {
+            options.csv_file = value;
+        } else if (flag == "--json") {
+            options.json_file = value;
+        } else {
+            return false;
+        }
+    }
+    return options.min_log >= 1 && options.max_log <= 30 && options.min_log <= options.max_log && options.repetitions >= 1;
+}
+
+
+/**
+ * @brief Returns the q-quantile (0 <= q <= 1) of sorted values, with linear interpolation.
+ */
+static double percentile(const std::vector<double>& sorted, double q) {
+    double position = q * (sorted.size() - 1);
+    size_t below = (size_t)position;
+    size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (position - below) * (sorted[above] - sorted[below]);
+}
+
+
+/**
+ * @brief Times the forward DFT of one version on one input.
+ *
+ * Each call starts from a copy of the input (the copy is included in the time, it is O(N)
+ * against O(N log N) for the transform). A sample runs enough calls to last at least
+ * min_sample_seconds, so that small sizes are above the clock resolution, and its time is
+ * divided by the number of calls.
+ *
+ * @return The time of every repetition in seconds, empty if the warmup call exceeded max_case_seconds.
+ */
+static std::vector<double> timeCase(const std::vector<std::complex<double>>& input, bool parallel, int version, const BenchmarkOptions& options) {
+    std::vector<std::complex<double>> work(input.size());
+
+    auto run = [&](int calls) {
+        auto start = std::chrono::steady_clock::now();
+        for (int c = 0; c < calls; c++) {
+            work = input;
+            forwardDFT(work, parallel, version);
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    };
+
+    // The first call also builds the cached plans
+    double first = run(1);
+    if (first > options.max_case_seconds) {
+        return {};
+    }
+    int calls = 1;
+    while (calls < (1 << 20) && run(calls) < options.min_sample_seconds) {
+        calls *= 2;
+    }
+    for (int w = 0; w < options.warmup; w++) {
+        run(calls);
+    }
+
+    std::vector<double> times;
+    for (int r = 0; r < options.repetitions; r++) {
+        times.push_back(run(calls) / calls);
+    }
+    return times;
+}
+
+
+/**
+ * @brief Formats a value relative to the V2 baseline, or missing when there is no baseline.
+ */
+static std::string baselineField(const BenchmarkResult& r, double value, const std::string& missing) {
+    if (!r.has_baseline) {
+        return missing;
+    }
+    std::ostringstream text;
+    text << std::setprecision(9) << value;
+    return text.str();
+}
+
+
+static void writeCSV(const std::string& filename, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(filename);
+    file << "mode,version,threads,N,repetitions,median_s,p10_s,p90_s,min_s,gflops,speedup_vs_v2,efficiency\n";
+    file << std::setprecision(9);
+    for (const BenchmarkResult& r : results) {
+        file << r.mode << "," << r.version << "," << r.threads << "," << r.N << "," << r.repetitions << ","
+             << r.median << "," << r.p10 << "," << r.p90 << "," << r.min << "," << r.gflops << ","
+             << baselineField(r, r.speedup, "") << "," << baselineField(r, r.efficiency, "") << "\n";
+    }
+}
+
+
+static void writeJSON(const std::string& filename, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(filename);
+    file << std::setprecision(9);
+    file << "{\n  \"build\": {\"compiler\": \"" << __VERSION__ << "\", \"date\": \"" << __DATE__ << " " << __TIME__ << "\", \"simd\": \""
+         << simdLevelName(activeSimdLevel()) << "\"},\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& r = results[i];
+        file << "    {\"mode\": \"" << r.mode << "\", \"version\": " << r.version << ", \"threads\": " << r.threads << ", \"N\": " << r.N
+             << ", \"repetitions\": " << r.repetitions << ", \"median_s\": " << r.median << ", \"p10_s\": " << r.p10 << ", \"p90_s\": " << r.p90
+             << ", \"min_s\": " << r.min << ", \"gflops\": " << r.gflops << ", \"speedup_vs_v2\": " << baselineField(r, r.speedup, "null")
+             << ", \"efficiency\": " << baselineField(r, r.efficiency, "null") << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+}
+
+
+/**
+ * @brief Sweeps N, the thread count and the versions, and reports timing statistics.
+ *
+ * For every size 2^min_log .. 2^max_log, each sequential version and each parallel version at
+ * each thread count is timed on the same random input. GFLOP/s use the usual 5 N log2(N) flop
+ * count of a complex FFT; speedup is against sequential DFT_V2 (version 2) at the same N and
+ * efficiency is speedup / threads (left empty, null in JSON, when V2 was not timed at that N).
+ * A version whose single call takes more than max_case_seconds is dropped for the larger sizes.
+ */
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<BenchmarkResult> results;
+    std::map<std::pair<std::string, int>, bool> dropped;
+    std::mt19937 generator(42);
+    std::normal_distribution<double> distribution;
+
+    std::cout << std::setprecision(4);
+    for (int log2N = options.min_log; log2N <= options.max_log; log2N++) {
+        int N = 1 << log2N;
+        std::vector<std::complex<double>> input(N);
+        for (auto& value : input) {
+            value = std::complex<double>(distribution(generator), distribution(generator));
+        }
+        double flops = 5.0 * N * log2N;
+        double baseline = 0.0;
+
+        // The sequential cases run first so that DFT_V2 is known before the others are reported
+        std::vector<std::pair<bool, int>> cases;
+        for (int version : options.sequential_versions) {
+            cases.push_back({false, version});
+        }
+        for (int version : options.parallel_versions) {
+            cases.push_back({true, version});
+        }
+        std::stable_partition(cases.begin(), cases.end(), [](const std::pair<bool, int>& c) { return !c.first && c.second == 2; });
+
+        for (const auto& c : cases) {
+            bool parallel = c.first;
+            int version = c.second;
+            if (!isValidVersion(parallel, version)) {
+                continue;
+            }
+            std::vector<int> thread_counts = parallel ? options.threads : std::vector<int>{1};
+
+            for (int threads : thread_counts) {
+                std::string mode = parallel ? "parallel" : "sequential";
+                std::string key = mode + " " + std::to_string(threads);
+                if (dropped[{key, version}]) {
+                    continue;
+                }
+                p = threads;
+                initThreadPool(threads);
+
+                std::vector<double> times = timeCase(input, parallel, version, options);
+                if (times.empty()) {
+                    dropped[{key, version}] = true;
+                    std::cout << versionLabel(parallel, version) << "N = " << N << ", " << threads << " thread(s): above " << options.max_case_seconds << " s per call, skipped from now on" << std::endl;
+                    continue;
+                }
+                std::sort(times.begin(), times.end());
+
+                BenchmarkResult result;
+                result.mode = mode;
+                result.version = version;
+                result.threads = threads;
+                result.N = N;
+                result.repetitions = times.size();
+                result.median = percentile(times, 0.5);
+                result.p10 = percentile(times, 0.1);
+                result.p90 = percentile(times, 0.9);
+                result.min = times.front();
+                result.gflops = flops / result.median / 1e9;
+                if (!parallel && version == 2) {
+                    baseline = result.median;
+                }
+                result.has_baseline = baseline > 0.0;
+                result.speedup = result.has_baseline ? baseline / result.median : 0.0;
+                result.efficiency = result.speedup / threads;
+                results.push_back(result);
+
+                std::cout << versionLabel(parallel, version) << "N = 2^" << log2N << ", " << threads << " thread(s): median " << COLOR_GREEN << result.median << " s" << COLOR_RESET
+                          << " (p10 " << result.p10 << ", p90 " << result.p90 << "), " << result.gflops << " GFLOP/s";
+                if (result.has_baseline) {
+                    std::cout << ", speedup vs V2 " << result.speedup << ", efficiency " << result.efficiency << std::endl;
+                } else {
+                    std::cout << ", no V2 baseline at this size" << std::endl;
+                }
+            }
+        }
+    }
+
+    writeCSV(options.csv_file, results);
+    writeJSON(options.json_file, results);
+    std::cout << COLOR_BLUE "[Benchmark] " COLOR_RESET << results.size() << " cases written to " << options.csv_file << " and " << options.json_file << std::endl;
+    return 0;
+}
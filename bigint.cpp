@@ -0,0 +1,404 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "dft_versions.h"
+#include "bigint.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_GREEN "\033[32m"
+#define COLOR_BLUE "\033[34m"
+#define COLOR_ORANGE "\033[38;5;208m"
+
+// Largest FFT limb, in decimal digits (10^6 squared times a few coefficients still fits in a double)
+const int BIGINT_MAX_LIMB_DIGITS = 6;
+// Bits of the 53-bit mantissa kept as a margin for the rounding error of the FFTs
+const double BIGINT_ERROR_MARGIN_BITS = 3.0;
+// Largest accepted distance between a product coefficient and the nearest integer
+const double BIGINT_MAX_ROUNDING_ERROR = 0.25;
+
+static const uint32_t powers_of_ten[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+
+/**
+ * @brief Runs body(first, last) over [0, n), on the thread pool in parallel mode.
+ */
+static void forRange(bool parallel, size_t n, const std::function<void(size_t, size_t)>& body) {
+    if (n == 0) {
+        return;
+    }
+    if (parallel) {
+        getThreadPool().parallel_for(0, n, [&](int first, int last) { body(first, last); });
+    } else {
+        body(0, n);
+    }
+}
+
+
+/**
+ * @brief Number of chunks of the loops that keep one result per chunk: a few per thread.
+ */
+static size_t chunkCount(size_t n, bool parallel) {
+    return parallel ? std::max<size_t>(1, std::min<size_t>(n, 4 * getThreadPool().size())) : 1;
+}
+
+
+static void trim(BigInt& value) {
+    while (!value.limbs.empty() && value.limbs.back() == 0) {
+        value.limbs.pop_back();
+    }
+    if (value.limbs.empty()) {
+        value.negative = false;
+    }
+}
+
+
+static size_t decimalDigits(const BigInt& value) {
+    if (value.limbs.empty()) {
+        return 0;
+    }
+    size_t digits = (value.limbs.size() - 1) * BIGINT_BASE_DIGITS;
+    for (uint32_t top = value.limbs.back(); top > 0; top /= 10) {
+        digits++;
+    }
+    return digits;
+}
+
+
+/**
+ * @brief Parses an optional '-' followed by decimal digits.
+ *
+ * @return false if the text is not a valid integer (value is then left unchanged).
+ */
+bool parseBigInt(const std::string& text, BigInt& value) {
+    size_t start = !text.empty() && text[0] == '-' ? 1 : 0;
+    if (start == text.size() || text.find_first_not_of("0123456789", start) != std::string::npos) {
+        return false;
+    }
+
+    BigInt result;
+    result.negative = start == 1;
+    for (size_t end = text.size(); end > start; ) {
+        size_t begin = end >= start + BIGINT_BASE_DIGITS ? end - BIGINT_BASE_DIGITS : start;
+        result.limbs.push_back(std::stoul(text.substr(begin, end - begin)));
+        end = begin;
+    }
+    trim(result);
+    value = result;
+    return true;
+}
+
+
+std::string bigIntToString(const BigInt& value) {
+    if (value.limbs.empty()) {
+        return "0";
+    }
+
+    std::string text = value.negative ? "-" : "";
+    text += std::to_string(value.limbs.back());
+    for (size_t i = value.limbs.size() - 1; i-- > 0; ) {
+        std::string limb = std::to_string(value.limbs[i]);
+        text += std::string(BIGINT_BASE_DIGITS - limb.size(), '0') + limb;
+    }
+    return text;
+}
+
+
+/**
+ * @brief Returns a random positive integer with exactly the given number of digits.
+ */
+BigInt randomBigInt(size_t digits, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<uint32_t> limb(0, BIGINT_BASE - 1);
+
+    BigInt value;
+    value.limbs.resize((digits + BIGINT_BASE_DIGITS - 1) / BIGINT_BASE_DIGITS);
+    for (auto& l : value.limbs) {
+        l = limb(generator);
+    }
+    if (!value.limbs.empty()) {
+        int top_digits = digits - (value.limbs.size() - 1) * BIGINT_BASE_DIGITS;
+        std::uniform_int_distribution<uint32_t> top(powers_of_ten[top_digits - 1], powers_of_ten[top_digits] - 1);
+        value.limbs.back() = top(generator);
+    }
+    return value;
+}
+
+
+/**
+ * @brief Picks the number of decimal digits of the FFT limbs for a product.
+ *
+ * multiplyBigInt squares z = a + ib, so the transform holds a * a and b * b besides a * b. With
+ * limbs in base B = 10^k and n = max(na, nb) limbs in the longer operand, all these coefficients
+ * are below n * B², and the FFT of size N adds a rounding error of about n * B² * log2(N) * 2^-53.
+ * k is the largest size for which 2 log2(B) + log2(n) + log2(log2(N)) stays
+ * BIGINT_ERROR_MARGIN_BITS below the 53-bit mantissa. This is an estimate of the typical error,
+ * not a worst-case bound: multiplyBigInt still checks the rounding and retries with smaller limbs.
+ */
+int chooseLimbDigits(size_t digits_a, size_t digits_b) {
+    for (int k = BIGINT_MAX_LIMB_DIGITS; k > 1; k--) {
+        double n = std::max<double>(1, (std::max(digits_a, digits_b) + k - 1) / k);
+        double N = std::max<double>(2, (double)(digits_a + digits_b) / k);
+        double bits = 2 * k * std::log2(10.0) + std::log2(n) + std::log2(std::log2(N));
+        if (bits + BIGINT_ERROR_MARGIN_BITS <= 53) {
+            return k;
+        }
+    }
+    return 1;
+}
+
+
+/**
+ * @brief Returns the digit groups of k decimal digits of |value|, least significant first.
+ */
+static std::vector<double> splitLimbs(const BigInt& value, int k, bool parallel) {
+    size_t digits = value.limbs.size() * BIGINT_BASE_DIGITS;
+    std::vector<double> groups((digits + k - 1) / k);
+
+    forRange(parallel, groups.size(), [&](size_t first, size_t last) {
+        for (size_t g = first; g < last; g++) {
+            uint32_t group = 0;
+            for (int d = std::min<size_t>(k, digits - g * k) - 1; d >= 0; d--) {
+                size_t position = g * k + d;
+                uint32_t digit = value.limbs[position / BIGINT_BASE_DIGITS] / powers_of_ten[position % BIGINT_BASE_DIGITS] % 10;
+                group = group * 10 + digit;
+            }
+            groups[g] = group;
+        }
+    });
+    return groups;
+}
+
+
+/**
+ * @brief Gathers digit groups of k decimal digits (each below 10^k) into base 10^9 limbs.
+ */
+static std::vector<uint32_t> joinLimbs(const std::vector<int64_t>& groups, int k, bool parallel) {
+    size_t digits = groups.size() * k;
+    std::vector<uint32_t> limbs((digits + BIGINT_BASE_DIGITS - 1) / BIGINT_BASE_DIGITS);
+
+    forRange(parallel, limbs.size(), [&](size_t first, size_t last) {
+        for (size_t l = first; l < last; l++) {
+            uint32_t limb = 0;
+            for (int d = std::min<size_t>(BIGINT_BASE_DIGITS, digits - l * BIGINT_BASE_DIGITS) - 1; d >= 0; d--) {
+                size_t position = l * BIGINT_BASE_DIGITS + d;
+                uint32_t digit = groups[position / k] / powers_of_ten[position % k] % 10;
+                limb = limb * 10 + digit;
+            }
+            limbs[l] = limb;
+        }
+    });
+    return limbs;
+}
+
+
+/**
+ * @brief Brings every coefficient into [0, base) by propagating the carries, in place.
+ *
+ * Each chunk is first normalized on its own, in parallel, leaving one outgoing carry per chunk.
+ * A short sequential pass then adds each carry to the next chunk; it only ripples as far as
+ * the carry changes digits (a few of them, except for long runs of base - 1).
+ *
+ * @param coefficients Non-negative coefficients, with enough high zero entries to absorb the last carry.
+ */
+static void propagateCarries(std::vector<int64_t>& coefficients, int64_t base, bool parallel) {
+    size_t n = coefficients.size();
+    size_t num_chunks = chunkCount(n, parallel);
+    std::vector<int64_t> carry_out(num_chunks, 0);
+    auto chunkBegin = [&](size_t c) { return n * c / num_chunks; };
+
+    forRange(parallel, num_chunks, [&](size_t first, size_t last) {
+        for (size_t c = first; c < last; c++) {
+            int64_t carry = 0;
+            for (size_t i = chunkBegin(c); i < chunkBegin(c + 1); i++) {
+                int64_t value = coefficients[i] + carry;
+                coefficients[i] = value % base;
+                carry = value / base;
+            }
+            carry_out[c] = carry;
+        }
+    });
+
+    int64_t carry = 0;
+    for (size_t c = 0; c < num_chunks; c++) {
+        size_t i = chunkBegin(c);
+        for (; carry != 0 && i < chunkBegin(c + 1); i++) {
+            int64_t value = coefficients[i] + carry;
+            coefficients[i] = value % base;
+            carry = value / base;
+        }
+        carry += carry_out[c];
+    }
+}
+
+
+/**
+ * @brief Product of two integers of any size through an FFT convolution of their digit groups.
+ *
+ * The limbs are regrouped into FFT limbs of k decimal digits (see chooseLimbDigits). With
+ * z = a + ib, Im(z * z) / 2 = a * b for the cyclic convolution, so one forward and one inverse
+ * transform of size N >= na + nb - 1 give the whole product. Every coefficient is rounded to
+ * the nearest integer and the carries are propagated; if a coefficient is further than
+ * BIGINT_MAX_ROUNDING_ERROR from an integer, the product is recomputed with smaller limbs.
+ *
+ * @param a First factor.
+ * @param b Second factor.
+ * @param parallel Boolean indicating whether to use parallel computation (transforms, rounding and carries).
+ * @param version Version of the DFT algorithm to use.
+ * @return a * b.
+ */
+BigInt multiplyBigInt(const BigInt& a, const BigInt& b, bool parallel, int version) {
+    BigInt product;
+    if (a.limbs.empty() || b.limbs.empty()) {
+        return product;
+    }
+
+    for (int k = chooseLimbDigits(decimalDigits(a), decimalDigits(b)); k >= 1; k--) {
+        std::vector<double> groups_a = splitLimbs(a, k, parallel);
+        std::vector<double> groups_b = splitLimbs(b, k, parallel);
+        size_t length = groups_a.size() + groups_b.size() - 1;
+        size_t N = 1;
+        while (N < length) {
+            N <<= 1;
+        }
+
+        std::vector<std::complex<double>> z(N);
+        forRange(parallel, N, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                z[i] = std::complex<double>(i < groups_a.size() ? groups_a[i] : 0.0, i < groups_b.size() ? groups_b[i] : 0.0);
+            }
+        });
+
+        forwardDFT(z, parallel, version);
+        forRange(parallel, N, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                z[i] *= z[i];
+            }
+        });
+        inverseDFT(z, parallel, version);
+
+        // Room for the carry out of the top coefficient: it is below n * 10^2k, i.e. a few groups
+        std::vector<int64_t> coefficients(length + 64 / k + 1, 0);
+        size_t num_chunks = chunkCount(length, parallel);
+        std::vector<double> chunk_error(num_chunks, 0.0);
+        forRange(parallel, num_chunks, [&](size_t first, size_t last) {
+            for (size_t c = first; c < last; c++) {
+                for (size_t i = length * c / num_chunks; i < length * (c + 1) / num_chunks; i++) {
+                    double value = z[i].imag() / 2;
+                    double rounded = std::nearbyint(value);
+                    chunk_error[c] = std::max(chunk_error[c], std::abs(value - rounded));
+                    coefficients[i] = (int64_t) rounded;
+                }
+            }
+        });
+
+        double max_error = *std::max_element(chunk_error.begin(), chunk_error.end());
+        if (max_error > BIGINT_MAX_ROUNDING_ERROR && k > 1) {
+            std::cerr << COLOR_ORANGE "[BigInt] " COLOR_RESET << "Rounding error " << max_error << " with " << k << "-digit limbs, retrying with " << k - 1 << "-digit limbs" << std::endl;
+            continue;
+        }
+
+        propagateCarries(coefficients, powers_of_ten[k], parallel);
+        product.limbs = joinLimbs(coefficients, k, parallel);
+        break;
+    }
+
+    product.negative = a.negative != b.negative;
+    trim(product);
+    return product;
+}
+
+
+/**
+ * @brief Product of two integers with the schoolbook algorithm on base 10^9 limbs (O(na * nb)), for reference.
+ */
+BigInt multiplyBigIntSchoolbook(const BigInt& a, const BigInt& b) {
+    BigInt product;
+    if (a.limbs.empty() || b.limbs.empty()) {
+        return product;
+    }
+
+    product.limbs.assign(a.limbs.size() + b.limbs.size(), 0);
+    for (size_t i = 0; i < a.limbs.size(); i++) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.limbs.size(); j++) {
+            uint64_t value = product.limbs[i + j] + (uint64_t) a.limbs[i] * b.limbs[j] + carry;
+            product.limbs[i + j] = value % BIGINT_BASE;
+            carry = value / BIGINT_BASE;
+        }
+        for (size_t j = i + b.limbs.size(); carry != 0; j++) {
+            uint64_t value = product.limbs[j] + carry;
+            product.limbs[j] = value % BIGINT_BASE;
+            carry = value / BIGINT_BASE;
+        }
+    }
+
+    product.negative = a.negative != b.negative;
+    trim(product);
+    return product;
+}
+
+
+/**
+ * @brief Residue of |value| modulo the Mersenne prime 2^61 - 1, to check a product in O(n).
+ */
+static uint64_t residue(const BigInt& value) {
+    const uint64_t prime = (1ULL << 61) - 1;
+    unsigned __int128 result = 0;
+    for (size_t i = value.limbs.size(); i-- > 0; ) {
+        result = (result * BIGINT_BASE + value.limbs[i]) % prime;
+    }
+    return (uint64_t) result;
+}
+
+
+/**
+ * @brief Multiplies two random integers of the given number of digits and reports the timings.
+ *
+ * The FFT product is checked modulo 2^61 - 1 and, on the first 20000 digits, against the
+ * schoolbook product, whose time is extrapolated quadratically to the full size.
+ *
+ * @param digits Number of decimal digits of each factor.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm to use.
+ */
+void bigint_multiplication(size_t digits, bool parallel, int version) {
+    std::string label = versionLabel(parallel, version);
+
+    BigInt a = randomBigInt(digits, 1);
+    BigInt b = randomBigInt(digits, 2);
+
+    auto start_time = std::chrono::steady_clock::now();
+    BigInt product = multiplyBigInt(a, b, parallel, version);
+    std::chrono::duration<double> fft_time = std::chrono::steady_clock::now() - start_time;
+
+    const uint64_t prime = (1ULL << 61) - 1;
+    bool correct = residue(product) == (uint64_t) ((unsigned __int128) residue(a) * residue(b) % prime);
+
+    std::cout << label << digits << "-digit operands, " << chooseLimbDigits(digits, digits) << "-digit FFT limbs, " << decimalDigits(product) << "-digit product" << std::endl;
+    std::cout << label << "Time taken for the FFT multiplication: " << COLOR_GREEN << fft_time.count() << " seconds" << COLOR_RESET
+              << (correct ? " (checked modulo 2^61 - 1)" : COLOR_ORANGE " (WRONG residue modulo 2^61 - 1)" COLOR_RESET) << std::endl;
+
+    size_t small_digits = std::min<size_t>(digits, 20000);
+    BigInt small_a = randomBigInt(small_digits, 3);
+    BigInt small_b = randomBigInt(small_digits, 4);
+
+    start_time = std::chrono::steady_clock::now();
+    BigInt schoolbook = multiplyBigIntSchoolbook(small_a, small_b);
+    std::chrono::duration<double> schoolbook_time = std::chrono::steady_clock::now() - start_time;
+    bool same = multiplyBigInt(small_a, small_b, parallel, version).limbs == schoolbook.limbs;
+
+    double scale = (double) digits / small_digits;
+    double estimated = schoolbook_time.count() * scale * scale;
+    std::cout << COLOR_BLUE << "[Schoolbook] " << COLOR_RESET << "Time taken for " << small_digits << " digits: " << COLOR_GREEN << schoolbook_time.count() << " seconds" << COLOR_RESET
+              << (same ? " (same product as the FFT)" : COLOR_ORANGE " (DIFFERENT product from the FFT)" COLOR_RESET) << std::endl;
+    std::cout << COLOR_BLUE << "[Schoolbook] " << COLOR_RESET << "Estimated time for " << digits << " digits: " << COLOR_GREEN << estimated << " seconds" << COLOR_RESET
+              << " (" << estimated / fft_time.count() << "x the FFT multiplication)" << std::endl;
+}
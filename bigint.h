@@ -0,0 +1,30 @@
+#ifndef BIGINT_H
+#define BIGINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Integer of any size: base 10^9 limbs, least significant first, and a sign.
+ *
+ * Zero has no limbs and is never negative.
+ */
+struct BigInt {
+    std::vector<uint32_t> limbs;
+    bool negative = false;
+};
+
+const uint32_t BIGINT_BASE = 1000000000;
+const int BIGINT_BASE_DIGITS = 9;
+
+bool parseBigInt(const std::string& text, BigInt& value);
+std::string bigIntToString(const BigInt& value);
+BigInt randomBigInt(size_t digits, unsigned seed);
+int chooseLimbDigits(size_t digits_a, size_t digits_b);
+BigInt multiplyBigInt(const BigInt& a, const BigInt& b, bool parallel, int version);
+BigInt multiplyBigIntSchoolbook(const BigInt& a, const BigInt& b);
+void bigint_multiplication(size_t digits, bool parallel, int version);
+
+#endif
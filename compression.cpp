@@ -1,21 +1,20 @@
 #include <algorithm>
 #include <complex>
+#include <cmath>
+#include <functional>
 #include <chrono>
 #include <iostream>
+#include <string>
 #include <vector>
 
-#include "parallel_dft/parallel_DFT_V0.h"
-#include "parallel_dft/parallel_DFT_V1.h"
-#include "parallel_dft/parallel_DFT_V2.h"
-#include "sequential_dft/sequential_DFT_V1.h"
-#include "sequential_dft/sequential_DFT_V2.h"
-
+#include "dft_versions.h"
+#include "real_dft.h"
+#include "full_dft.h"
 #include "compression.h"
 
 #define COLOR_RESET "\033[0m"
 #define COLOR_ORANGE "\033[38;5;214m"
 #define COLOR_GREEN "\033[32m"
-#define COLOR_BLUE "\033[34m"
 
 
 /**
@@ -34,12 +33,16 @@ bool compare( std::complex<double>& a,  std::complex<double>& b) {
  * @brief Prepares a boolean mask for compressing a signal by keeping the k largest terms.
  * 
  * @param x Input vector of complex numbers.
- * @param k Number of largest terms to keep.
+ * @param k Number of largest terms to keep (clamped to the size of x, none if k <= 0).
  * @return A vector of booleans indicating which terms to keep.
  */
 std::vector<bool> precompress(std::vector<std::complex<double>>& x, int k) {
-    std::vector<std::complex<double>> sorted_x = x;
     std::vector<bool> list_index( x.size());
+    k = std::min(k, (int) x.size());
+    if (k <= 0) {
+        return list_index;
+    }
+    std::vector<std::complex<double>> sorted_x = x;
     std::sort(sorted_x.begin(), sorted_x.end(), compare);
 
     double kth_largest = std::abs(sorted_x[k - 1]);
@@ -57,6 +60,43 @@ std::vector<bool> precompress(std::vector<std::complex<double>>& x, int k) {
 }
 
 
+/**
+ * @brief Prepares the compression mask from the N/2 + 1 bins of a real signal's spectrum.
+ * 
+ * Gives the same mask as precompress on the full spectrum: bin i > N/2 has the magnitude of bin N - i.
+ * 
+ * @param half_spectrum Bins X_0 .. X_{N/2}, as returned by realDFT.
+ * @param N Size of the signal.
+ * @param k Number of largest terms to keep (clamped to N, none if k <= 0).
+ * @return A vector of N booleans indicating which terms to keep.
+ */
+template <typename T>
+std::vector<bool> precompressReal(const std::vector<std::complex<T>>& half_spectrum, int N, int k) {
+    k = std::min(k, N);
+    if (k <= 0) {
+        return std::vector<bool>(N);
+    }
+
+    std::vector<T> magnitudes(N);
+    for (int i = 0; i < N; i++) {
+        magnitudes[i] = std::abs(half_spectrum[i <= N / 2 ? i : N - i]);
+    }
+
+    std::vector<T> sorted_magnitudes = magnitudes;
+    std::nth_element(sorted_magnitudes.begin(), sorted_magnitudes.begin() + (k - 1), sorted_magnitudes.end(), std::greater<T>());
+    T kth_largest = sorted_magnitudes[k - 1];
+
+    std::vector<bool> list_index(N);
+    for (int i = 0; i < N; i++) {
+        list_index[i] = magnitudes[i] >= kth_largest;
+    }
+    return list_index;
+}
+
+template std::vector<bool> precompressReal<float>(const std::vector<std::complex<float>>& half_spectrum, int N, int k);
+template std::vector<bool> precompressReal<double>(const std::vector<std::complex<double>>& half_spectrum, int N, int k);
+
+
 /**
  * @brief Computes the absolute error between two vectors of complex numbers.
  * 
@@ -73,117 +113,136 @@ double computeCompressionAbsoluteError(const std::vector<std::complex<double>>&
     return results/vec1.size();
 }
 
-/*
- * Computes the Nth roots of unity for a given integer N.
- * @param N The number of roots of unity to compute.
- * @return A dynamically allocated array of std::complex<double> containing the roots of unity.
- */
-std::vector<std::complex<double>> root_of_unity(int N) {
-    std::vector<std::complex<double>> ROOTS(N);
-    for (int k = 0; k < N; ++k) {
-        std::complex<double> rootk(cos(k * M_PI * 2 / N), sin(k * M_PI * 2 / N));
-        ROOTS[k] = rootk;
-    }
-    return ROOTS;
-}
-
-
-
 /**
  * @brief Approximates a signal using the DFT, keeping only the k largest terms.
  * 
+ * Any size is accepted: for sizes that are not a power of 2, the radix-2 versions are replaced
+ * by the mixed-radix version of the same mode (see resolveVersion).
+ * 
  * @param data Input vector of complex numbers.
  * @param k Number of largest terms to keep.
  * @param parallel Boolean indicating whether to use parallel computation.
  * @param version Version of the DFT algorithm to use.
  */
 void approximation(std::vector<std::complex<double>>& data, int k, bool parallel, int version){
-    
-    if (!parallel) {
-
-        std::vector<std::complex<double>> original_data = data;
-        auto start = std::chrono::high_resolution_clock::now();
-        std::vector<std::complex<double>> roots = root_of_unity(data.size());
-
-        switch (version) {
-            case 1:
-                DFT_V1(data, data.size());
-                break;
-            case 2:
-                DFT_V2(data, data.size());
-                break;
-        }
+    std::string kind = parallel ? "parallel" : "sequential";
 
-        std::vector<bool> to_remove = precompress(data, k);
+    int resolved = resolveVersion(data.size(), parallel, version);
+    if (resolved != version) {
+        std::cout << versionLabel(parallel, version) << "N = " << data.size() << " is not a power of 2, using V" << resolved << " instead" << std::endl;
+        version = resolved;
+    }
+    std::string label = versionLabel(parallel, version);
 
-        switch (version) {
-            case 1:
-                invDFT_V1(data);
-                break;
-            case 2:
-                invDFT_V2(data);
-                break;
-        }
+    std::vector<std::complex<double>> original_data = data;
+    auto start = std::chrono::high_resolution_clock::now();
 
-        for (int i = 0; i < data.size(); i++) {
-            if (to_remove[i]) {
-                data[i] = std::complex<double>(0, 0);
-            }
-        }
+    forwardDFT(data, parallel, version);
 
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> duration = end - start;
+    std::vector<bool> to_remove = precompress(data, k);
 
-        double error = computeCompressionAbsoluteError(original_data, data);
+    inverseDFT(data, parallel, version);
 
-        std::cout << COLOR_BLUE << "[Sequential V" << version << "] " << COLOR_RESET << "Time taken for the sequential compression process: " << COLOR_GREEN << duration.count() << " seconds" << COLOR_RESET << std::endl;
-        std::cout << COLOR_BLUE << "[Sequential V" << version << "] " << COLOR_RESET << "Error for the sequential compression process (DFT + invDFT + removal): " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
+    for (int i = 0; i < data.size(); i++) {
+        if (to_remove[i]) {
+            data[i] = std::complex<double>(0, 0);
+        }
+    }
 
-    } else {
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
 
-        std::vector<std::complex<double>> original_data = data;
-        auto start = std::chrono::high_resolution_clock::now();
-        std::vector<std::complex<double>> roots = root_of_unity(data.size());
+    double error = computeCompressionAbsoluteError(original_data, data);
 
-        switch (version) {
-            case 0:
-                DFT_parallel_V0(data);
-                break;
-            case 1:
-                DFT_parallel_V1(data);
-                break;
-            case 2:
-                DFT_parallel_V2(data);
-                break;
-        }
+    std::cout << label << "Time taken for the " << kind << " compression process: " << COLOR_GREEN << duration.count() << " seconds" << COLOR_RESET << std::endl;
+    std::cout << label << "Error for the " << kind << " compression process (DFT + invDFT + removal): " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
 
-        std::vector<bool> to_remove = precompress(data, k);
-
-        switch (version) {
-            case 0:
-                invDFT_parallel_V0(data);
-                break;
-            case 1:
-                invDFT_parallel_V1(data);
-                break;
-            case 2:
-                invDFT_parallel_V2(data);
-                break;
-        }
-        
-        for (int i = 0; i < data.size(); i++) {
-            if (to_remove[i]) {
-                data[i] = std::complex<double>(0, 0);
-            }
+    // Same process in single precision (the mask is chosen on the widened spectrum)
+    std::vector<std::complex<float>> single_data(original_data.begin(), original_data.end());
+    auto single_start = std::chrono::high_resolution_clock::now();
+    forwardDFT(single_data, parallel, version);
+    std::vector<std::complex<double>> single_spectrum = toDoublePrecision(single_data);
+    std::vector<bool> single_to_remove = precompress(single_spectrum, k);
+    inverseDFT(single_data, parallel, version);
+    for (size_t i = 0; i < single_data.size(); i++) {
+        if (single_to_remove[i]) {
+            single_data[i] = std::complex<float>(0, 0);
         }
+    }
+    auto single_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> single_duration = single_end - single_start;
+
+    std::vector<std::complex<double>> single_result = toDoublePrecision(single_data);
+    std::cout << label << "Time taken for the single-precision compression process: " << COLOR_GREEN << single_duration.count() << " seconds" << COLOR_RESET << std::endl;
+    std::cout << label << "Error for the single-precision compression process: " << COLOR_ORANGE << computeAbsoluteError(original_data, single_result) << COLOR_RESET
+              << ", difference with double precision: " << COLOR_ORANGE << computeAbsoluteError(data, single_result) << COLOR_RESET << std::endl;
+}
+
+
+/**
+ * @brief Keeps the k largest terms of a real signal's spectrum, in the precision T.
+ * 
+ * @param data Input vector of real numbers, replaced by its approximation.
+ * @param k Number of largest terms to keep.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm to use for the half-length transforms.
+ */
+template <typename T>
+static void compressReal(std::vector<T>& data, int k, bool parallel, int version) {
+    int N = data.size();
 
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> duration = end - start;
+    std::vector<std::complex<T>> spectrum = realDFT(data, parallel, version);
 
-        double error = computeCompressionAbsoluteError(original_data, data);
+    std::vector<bool> to_remove = precompressReal(spectrum, N, k);
 
-        std::cout << COLOR_BLUE << "[Parallel V" << version << "] " << COLOR_RESET << "Time taken for the parallel compression process: " << COLOR_GREEN << duration.count() << " seconds" << COLOR_RESET << std::endl;
-        std::cout << COLOR_BLUE << "[Parallel V" << version << "] " << COLOR_RESET << "Error for the parallel compression process (DFT + invDFT + removal): " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
+    data = invRealDFT(spectrum, N, parallel, version);
 
+    for (int i = 0; i < N; i++) {
+        if (to_remove[i]) {
+            data[i] = T(0);
+        }
     }
 }
+
+
+/**
+ * @brief Approximates a real signal using the real-input DFT, keeping only the k largest terms.
+ * 
+ * Same process as the complex version, but the forward and inverse transforms go through
+ * realDFT / invRealDFT, which only compute and store the N/2 + 1 non-redundant bins.
+ * The process is then repeated in single precision, and the time and the accuracy of both
+ * precisions are reported.
+ * 
+ * @param data Input vector of real numbers.
+ * @param k Number of largest terms to keep.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm to use for the half-length transforms.
+ */
+void approximation(std::vector<double>& data, int k, bool parallel, int version){
+    std::string kind = parallel ? "parallel" : "sequential";
+    std::string label = versionLabel(parallel, version);
+
+    std::vector<double> original_data = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    compressReal(data, k, parallel, version);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    std::vector<float> single_data(original_data.begin(), original_data.end());
+    auto single_start = std::chrono::high_resolution_clock::now();
+    compressReal(single_data, k, parallel, version);
+    auto single_end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> single_duration = single_end - single_start;
+
+    std::vector<std::complex<double>> original(original_data.begin(), original_data.end());
+    std::vector<std::complex<double>> result(data.begin(), data.end());
+    std::vector<std::complex<double>> single_result(single_data.begin(), single_data.end());
+    double error = computeAbsoluteError(original, result);
+    double single_error = computeAbsoluteError(original, single_result);
+
+    std::cout << label << "Time taken for the " << kind << " real-input compression process: " << COLOR_GREEN << duration.count() << " seconds" << COLOR_RESET << std::endl;
+    std::cout << label << "Error for the " << kind << " real-input compression process (R2C DFT + C2R invDFT + removal): " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
+    std::cout << label << "Time taken for the single-precision real-input compression process: " << COLOR_GREEN << single_duration.count() << " seconds" << COLOR_RESET << std::endl;
+    std::cout << label << "Error for the single-precision real-input compression process: " << COLOR_ORANGE << single_error << COLOR_RESET
+              << ", difference with double precision: " << COLOR_ORANGE << computeAbsoluteError(result, single_result) << COLOR_RESET << std::endl;
+}
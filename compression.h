@@ -6,7 +6,10 @@
 
 bool compare(std::complex<double>& a, std::complex<double>& b);
 std::vector<bool> precompress(std::vector<std::complex<double>>& x, int k);
+template <typename T>
+std::vector<bool> precompressReal(const std::vector<std::complex<T>>& half_spectrum, int N, int k);
 double computeAbsoluteError(const std::vector<std::complex<double>>& vec1, const std::vector<std::complex<double>>& vec2);
 void approximation(std::vector<std::complex<double>>& data, int k, bool parallel, int version);
+void approximation(std::vector<double>& data, int k, bool parallel, int version);
 
 #endif
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "dft_versions.h"
+#include "convolution.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_BLUE "\033[34m"
+#define COLOR_ORANGE "\033[38;5;214m"
+#define COLOR_GREEN "\033[32m"
+
+// Smallest transform used for a block, whatever the filter length
+const int CONVOLUTION_MIN_LENGTH = 16;
+
+
+bool parseConvolutionMethod(const std::string& name, ConvolutionMethod& method) {
+    if (name == "add") {
+        method = ConvolutionMethod::OverlapAdd;
+    } else if (name == "save") {
+        method = ConvolutionMethod::OverlapSave;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+
+const char* convolutionMethodName(ConvolutionMethod method) {
+    return method == ConvolutionMethod::OverlapAdd ? "overlap-add" : "overlap-save";
+}
+
+
+/**
+ * @brief Picks the transform length of the blocks for a filter and a signal length.
+ *
+ * Each block of N points produces N - M + 1 output samples (M = filter length), so the cost
+ * per output sample is about N log2 N / (N - M + 1): it is minimised over the powers of 2 from
+ * 2M up to the length of the whole convolution. The length is then halved while there are
+ * fewer than min_block_pairs pairs of blocks, so that every thread of the pool gets work.
+ *
+ * @return A power of 2, at least 2M and CONVOLUTION_MIN_LENGTH.
+ */
+int chooseConvolutionLength(int filter_length, int signal_length, int min_block_pairs) {
+    long total = (long) signal_length + filter_length - 1;
+
+    int smallest = CONVOLUTION_MIN_LENGTH;
+    while (smallest < 2 * filter_length) {
+        smallest <<= 1;
+    }
+    int largest = smallest;
+    while (largest < total) {
+        largest <<= 1;
+    }
+
+    int best = smallest;
+    double best_cost = std::numeric_limits<double>::max();
+    for (int N = smallest; N <= largest; N <<= 1) {
+        double cost = N * std::log2(N) / (N - filter_length + 1);
+        if (cost < best_cost) {
+            best = N;
+            best_cost = cost;
+        }
+    }
+
+    auto blockPairs = [&](int N) {
+        long blocks = (total + (N - filter_length)) / (N - filter_length + 1);
+        return (blocks + 1) / 2;
+    };
+    while (best > smallest && blockPairs(best) < min_block_pairs) {
+        best >>= 1;
+    }
+    return best;
+}
+
+
+/**
+ * @brief Prepares the convolution of signals of about signal_length samples with a filter.
+ *
+ * @param filter Filter taps (impulse response).
+ * @param signal_length Expected signal length, used to choose the block size.
+ * @param method Overlap-add or overlap-save.
+ * @param parallel Boolean indicating whether to share the blocks out over the thread pool.
+ * @param version Version of the DFT algorithm used for the blocks. In parallel mode the blocks
+ *        run inside pool tasks, where the parallel version runs on the calling thread.
+ * @param fft_length Transform length of the blocks (a power of 2 of at least twice the filter
+ *        length), or 0 to choose it with chooseConvolutionLength.
+ */
+BlockConvolver::BlockConvolver(const std::vector<double>& filter, int signal_length, ConvolutionMethod method, bool parallel, int version, int fft_length)
+    : filter_length(std::max<int>(filter.size(), 1)), convolution_method(method), parallel(parallel), version(version) {
+    int min_block_pairs = parallel ? getThreadPool().size() : 1;
+    N = fft_length > 0 ? fft_length : chooseConvolutionLength(filter_length, signal_length, min_block_pairs);
+    L = N - filter_length + 1;
+    if (!isPowerOfTwo(N) || L < filter_length - 1) {
+        std::cerr << "Invalid block length " << N << " for a filter of " << filter_length << " taps: using "
+                  << chooseConvolutionLength(filter_length, signal_length, min_block_pairs) << std::endl;
+        N = chooseConvolutionLength(filter_length, signal_length, min_block_pairs);
+        L = N - filter_length + 1;
+    }
+
+    this->version = resolveVersion(N, parallel, version);
+    filter_spectrum.assign(N, 0.0);
+    std::copy(filter.begin(), filter.end(), filter_spectrum.begin());
+    forwardDFT(filter_spectrum, parallel, this->version);
+}
+
+
+/**
+ * @brief Circular convolution of two real blocks with the filter, in place.
+ *
+ * The blocks are the real and imaginary parts of pair: since the filter spectrum is that of a
+ * real filter, the real and imaginary parts of the result are the two filtered blocks.
+ */
+void BlockConvolver::filterPair(std::vector<std::complex<double>>& pair) const {
+    forwardDFT(pair, parallel, version);
+    for (int k = 0; k < N; k++) {
+        pair[k] *= filter_spectrum[k];
+    }
+    inverseDFT(pair, parallel, version);
+}
+
+
+/**
+ * @brief Returns the full linear convolution of signal with the filter (signal.size() + M - 1 samples).
+ *
+ * Overlap-save: block b covers the outputs [bL, bL + L) and reads the inputs [bL - M + 1, bL + L);
+ * the first M - 1 samples of its circular convolution are discarded. The blocks never write to
+ * the same output, so each pair of blocks is filtered independently.
+ *
+ * Overlap-add: block b reads the inputs [bL, bL + L), zero-padded to N points, and its convolution
+ * covers the outputs [bL, bL + N). The first L outputs belong to the block alone and are written
+ * directly; the last M - 1 overlap the next block and are added in a second pass.
+ */
+std::vector<double> BlockConvolver::convolve(const std::vector<double>& signal) const {
+    if (signal.empty()) {
+        return {};
+    }
+
+    long n = signal.size();
+    int M = filter_length;
+    long total = n + M - 1;
+    bool overlap_save = convolution_method == ConvolutionMethod::OverlapSave;
+    long num_blocks = overlap_save ? (total + L - 1) / L : (n + L - 1) / L;
+    long num_pairs = (num_blocks + 1) / 2;
+
+    std::vector<double> output(total, 0.0);
+    std::vector<double> tails(overlap_save ? 0 : (size_t) num_blocks * (M - 1));
+
+    auto filterPairs = [&](int first, int last) {
+        thread_local std::vector<std::complex<double>> pair;
+        pair.resize(N);
+
+        for (long q = first; q < last; q++) {
+            long block[2] = {2 * q, 2 * q + 1};
+
+            for (int j = 0; j < N; j++) {
+                double values[2] = {0.0, 0.0};
+                for (int side = 0; side < 2; side++) {
+                    long index = overlap_save ? block[side] * L - (M - 1) + j : block[side] * L + j;
+                    bool inside = overlap_save || j < L;
+                    if (inside && block[side] < num_blocks && index >= 0 && index < n) {
+                        values[side] = signal[index];
+                    }
+                }
+                pair[j] = std::complex<double>(values[0], values[1]);
+            }
+
+            filterPair(pair);
+
+            for (int side = 0; side < 2 && block[side] < num_blocks; side++) {
+                long b = block[side];
+                int offset = overlap_save ? M - 1 : 0;
+                for (int j = 0; j < L && b * L + j < total; j++) {
+                    const std::complex<double>& value = pair[offset + j];
+                    output[b * L + j] = side == 0 ? value.real() : value.imag();
+                }
+                if (!overlap_save) {
+                    for (int j = 0; j < M - 1; j++) {
+                        const std::complex<double>& value = pair[L + j];
+                        tails[(size_t) b * (M - 1) + j] = side == 0 ? value.real() : value.imag();
+                    }
+                }
+            }
+        }
+    };
+
+    auto addTails = [&](int first, int last) {
+        for (long b = first; b < last; b++) {
+            for (int j = 0; j < M - 1 && (b + 1) * L + j < total; j++) {
+                output[(b + 1) * L + j] += tails[(size_t) b * (M - 1) + j];
+            }
+        }
+    };
+
+    if (parallel) {
+        ThreadPool& pool = getThreadPool();
+        pool.parallel_for(0, (int) num_pairs, filterPairs);
+        if (!overlap_save) {
+            pool.parallel_for(0, (int) num_blocks, addTails);
+        }
+    } else {
+        filterPairs(0, num_pairs);
+        if (!overlap_save) {
+            addTails(0, num_blocks);
+        }
+    }
+    return output;
+}
+
+
+int BlockConvolver::fftLength() const {
+    return N;
+}
+
+
+int BlockConvolver::blockLength() const {
+    return L;
+}
+
+
+ConvolutionMethod BlockConvolver::method() const {
+    return convolution_method;
+}
+
+
+/**
+ * @brief Linear convolution from the definition (O(n M)), used as the reference.
+ */
+std::vector<double> convolveDirect(const std::vector<double>& signal, const std::vector<double>& filter) {
+    if (signal.empty() || filter.empty()) {
+        return {};
+    }
+    std::vector<double> output(signal.size() + filter.size() - 1, 0.0);
+    for (size_t i = 0; i < signal.size(); i++) {
+        for (size_t j = 0; j < filter.size(); j++) {
+            output[i + j] += signal[i] * filter[j];
+        }
+    }
+    return output;
+}
+
+
+/**
+ * @brief Returns a Hamming-windowed sinc low-pass filter with unit gain at frequency 0.
+ *
+ * @param taps Number of taps.
+ * @param cutoff Cutoff frequency in cycles per sample (below 0.5).
+ */
+std::vector<double> lowPassFilter(int taps, double cutoff) {
+    std::vector<double> filter(taps);
+    double center = (taps - 1) / 2.0;
+    double sum = 0.0;
+    for (int n = 0; n < taps; n++) {
+        double t = n - center;
+        double sinc = t == 0.0 ? 2 * cutoff : std::sin(2 * M_PI * cutoff * t) / (M_PI * t);
+        double window = taps > 1 ? 0.54 - 0.46 * std::cos(2 * M_PI * n / (taps - 1)) : 1.0;
+        filter[n] = sinc * window;
+        sum += filter[n];
+    }
+    for (double& tap : filter) {
+        tap /= sum;
+    }
+    return filter;
+}
+
+
+/**
+ * @brief Smooths a signal with a low-pass filter through block convolution and writes it to plots/.
+ *
+ * The filter keeps the periods longer than about a month (cutoff 1/32 cycles per sample). The
+ * block convolution is timed and compared with the direct convolution; the output file has one
+ * line per sample: index, original value and filtered value (delayed by (taps - 1) / 2 samples
+ * so that it lines up with the original).
+ *
+ * @param samples Signal to filter.
+ * @param taps Number of taps of the filter.
+ * @param method Overlap-add or overlap-save.
+ * @param fft_length Transform length of the blocks, 0 to choose it automatically.
+ * @param parallel Boolean indicating whether to share the blocks out over the thread pool.
+ * @param version Version of the DFT algorithm used for the blocks in sequential mode.
+ * @param mode "sequential" or "parallel", used in the output file name.
+ */
+void filter_signal(const std::vector<double>& samples, int taps, ConvolutionMethod method, int fft_length, bool parallel, int version, const std::string& mode) {
+    if (taps < 1 || samples.empty()) {
+        std::cerr << "Invalid filter: the filter needs at least one tap and the signal at least one sample" << std::endl;
+        return;
+    }
+
+    std::string label = versionLabel(parallel, version);
+    std::vector<double> filter = lowPassFilter(taps, 1.0 / 32);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    BlockConvolver convolver(filter, samples.size(), method, parallel, version, fft_length);
+    auto planned = std::chrono::high_resolution_clock::now();
+    std::vector<double> filtered = convolver.convolve(samples);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::vector<double> reference = convolveDirect(samples, filter);
+    auto direct_end = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration<double> setup_time = planned - start;
+    std::chrono::duration<double> convolution_time = end - planned;
+    std::chrono::duration<double> direct_time = direct_end - end;
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < filtered.size(); i++) {
+        max_error = std::max(max_error, std::abs(filtered[i] - reference[i]));
+    }
+
+    std::filesystem::create_directories("plots");
+    std::ostringstream oss;
+    oss << "plots/" << mode << "_filter_V" << versionName(version) << ".csv";
+    std::string filename = oss.str();
+    std::ofstream output(filename);
+    int delay = (taps - 1) / 2;
+    for (size_t i = 0; i < samples.size(); i++) {
+        output << i << "," << samples[i] << "," << filtered[i + delay] << "\n";
+    }
+
+    long single_length = 1;
+    while (single_length < (long) filtered.size()) {
+        single_length <<= 1;
+    }
+
+    std::cout << label << convolutionMethodName(convolver.method()) << " filtering of " << samples.size() << " samples with " << taps << " taps: blocks of "
+              << convolver.blockLength() << " samples, FFT length " << convolver.fftLength() << " (a single transform would need " << single_length << " points)" << std::endl;
+    std::cout << label << "Time taken for the block convolution: " << COLOR_GREEN << convolution_time.count() << " seconds" << COLOR_RESET
+              << " (filter spectrum: " << COLOR_GREEN << setup_time.count() << " seconds" << COLOR_RESET << ")" << std::endl;
+    std::cout << COLOR_BLUE << "[Direct convolution] " << COLOR_RESET << "Time taken: " << COLOR_GREEN << direct_time.count() << " seconds" << COLOR_RESET
+              << ", maximum difference with the block convolution: " << COLOR_ORANGE << max_error << COLOR_RESET << std::endl;
+    std::cout << label << "Filtered signal written to " << filename << std::endl;
+}
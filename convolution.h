@@ -0,0 +1,49 @@
+#ifndef CONVOLUTION_H
+#define CONVOLUTION_H
+
+#include <complex>
+#include <string>
+#include <vector>
+
+enum class ConvolutionMethod { OverlapAdd, OverlapSave };
+
+bool parseConvolutionMethod(const std::string& name, ConvolutionMethod& method);
+const char* convolutionMethodName(ConvolutionMethod method);
+int chooseConvolutionLength(int filter_length, int signal_length, int min_block_pairs);
+
+/**
+ * @brief Linear convolution of long real signals with a short real filter, block by block.
+ *
+ * The signal is cut into blocks of fftLength() - filter length + 1 samples, each convolved with
+ * the filter through transforms of fftLength() points (overlap-add or overlap-save). The filter
+ * spectrum is computed once by the constructor and reused by every block and every call. Two
+ * real blocks share one complex transform (as real and imaginary parts), and in parallel mode
+ * the pairs of blocks are shared out over the thread pool.
+ */
+class BlockConvolver {
+public:
+    BlockConvolver(const std::vector<double>& filter, int signal_length, ConvolutionMethod method, bool parallel, int version, int fft_length = 0);
+
+    std::vector<double> convolve(const std::vector<double>& signal) const;
+
+    int fftLength() const;
+    int blockLength() const;
+    ConvolutionMethod method() const;
+
+private:
+    void filterPair(std::vector<std::complex<double>>& pair) const;
+
+    int filter_length;
+    int N;
+    int L;
+    ConvolutionMethod convolution_method;
+    bool parallel;
+    int version;
+    std::vector<std::complex<double>> filter_spectrum;
+};
+
+std::vector<double> convolveDirect(const std::vector<double>& signal, const std::vector<double>& filter);
+std::vector<double> lowPassFilter(int taps, double cutoff);
+void filter_signal(const std::vector<double>& samples, int taps, ConvolutionMethod method, int fft_length, bool parallel, int version, const std::string& mode);
+
+#endif
@@ -0,0 +1,222 @@
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "fft_plan.h"
+#include "fft_radix.h"
+#include "profiler.h"
+#include "../parallel_dft/p_transpose.h"
+
+
+template <typename T>
+using PlanCache = std::map<std::tuple<int, bool, int, FFTAlgorithm>, std::unique_ptr<FFTPlanT<T>>>;
+
+// One cache per precision, both guarded by the same mutex
+template <typename T>
+static PlanCache<T>& planCache() {
+    static PlanCache<T> cache;
+    return cache;
+}
+static std::mutex plan_cache_mutex;
+
+// Twiddles of the real-input packing, per N (guarded by plan_cache_mutex too)
+template <typename T>
+static std::map<int, std::unique_ptr<std::vector<std::complex<T>>>>& packTwiddleCache() {
+    static std::map<int, std::unique_ptr<std::vector<std::complex<T>>>> cache;
+    return cache;
+}
+
+
+/**
+ * @brief Builds the twiddle and permutation tables for a transform of size N.
+ *
+ * @param N Size of the transform.
+ * @param inverse True for an inverse transform (conjugated twiddles and 1/N scaling).
+ * @param num_threads Number of threads the plan will be executed with.
+ * @param algorithm Butterfly algorithm used by executePlan.
+ * @return The new plan.
+ */
+template <typename T>
+FFTPlanT<T> createPlan(int N, bool inverse, int num_threads, FFTAlgorithm algorithm) {
+    PROFILE_STAGE("twiddles");
+
+    FFTPlanT<T> plan;
+    plan.N = N;
+    plan.inverse = inverse;
+    plan.num_threads = num_threads;
+    plan.algorithm = algorithm;
+
+    double sign = inverse ? 1.0 : -1.0;
+    plan.twiddle.resize(N);
+    for (int k = 0; k < N; k++) {
+        plan.twiddle[k] = std::complex<T>(std::polar(1.0, sign * 2 * M_PI * k / N));
+    }
+
+    if (N > 0 && (N & (N - 1)) == 0) {
+        int log2N = 0;
+        while ((1 << log2N) < N) {
+            log2N++;
+        }
+
+        plan.bitrev.resize(N);
+        for (int i = 0; i < N; i++) {
+            int reversed = 0;
+            for (int b = 0; b < log2N; b++) {
+                reversed |= ((i >> b) & 1) << (log2N - 1 - b);
+            }
+            plan.bitrev[i] = reversed;
+        }
+
+        plan.stage_twiddle_re.resize(N > 1 ? N - 1 : 0);
+        plan.stage_twiddle_im.resize(N > 1 ? N - 1 : 0);
+        for (int len = 2; len <= N; len <<= 1) {
+            int half = len / 2;
+            for (int j = 0; j < half; j++) {
+                const std::complex<T>& w = plan.twiddle[j * (N / len)];
+                plan.stage_twiddle_re[half - 1 + j] = w.real();
+                plan.stage_twiddle_im[half - 1 + j] = w.imag();
+            }
+        }
+    }
+
+    if (num_threads >= 1 && (num_threads & (num_threads - 1)) == 0) {
+        plan.block_sequence = chooseSequence(num_threads);
+    }
+
+    return plan;
+}
+
+
+/**
+ * @brief Returns the cached plan for (N, inverse, num_threads, algorithm), creating it on first use.
+ *
+ * The returned reference stays valid until clearPlanCache is called.
+ */
+template <typename T>
+const FFTPlanT<T>& getPlan(int N, bool inverse, int num_threads, FFTAlgorithm algorithm) {
+    std::lock_guard<std::mutex> lock(plan_cache_mutex);
+
+    PlanCache<T>& plan_cache = planCache<T>();
+    auto key = std::make_tuple(N, inverse, num_threads, algorithm);
+    auto it = plan_cache.find(key);
+    if (it == plan_cache.end()) {
+        it = plan_cache.emplace(key, std::make_unique<FFTPlanT<T>>(createPlan<T>(N, inverse, num_threads, algorithm))).first;
+    }
+    return *it->second;
+}
+
+
+/**
+ * @brief Returns the cached twiddles exp(-2iπk/N), k = 0 .. N/2, used to split or merge the
+ * half-length transform of a real signal of size N (realDFT, invRealDFT, multiply).
+ *
+ * Only these N/2 + 1 values are stored: unlike a full plan, no bit-reversal or stage tables are
+ * built. The returned reference stays valid until clearPlanCache is called.
+ */
+template <typename T>
+const std::vector<std::complex<T>>& getPackTwiddles(int N) {
+    std::lock_guard<std::mutex> lock(plan_cache_mutex);
+
+    auto& cache = packTwiddleCache<T>();
+    auto it = cache.find(N);
+    if (it == cache.end()) {
+        auto twiddles = std::make_unique<std::vector<std::complex<T>>>(N / 2 + 1);
+        for (int k = 0; k <= N / 2; k++) {
+            (*twiddles)[k] = std::complex<T>(std::polar(1.0, -2 * M_PI * k / N));
+        }
+        it = cache.emplace(N, std::move(twiddles)).first;
+    }
+    return *it->second;
+}
+
+
+const char* algorithmName(FFTAlgorithm algorithm) {
+    switch (algorithm) {
+        case FFTAlgorithm::Radix4:
+            return "radix-4";
+        case FFTAlgorithm::Radix8:
+            return "radix-8";
+        case FFTAlgorithm::SplitRadix:
+            return "split-radix";
+        default:
+            return "radix-2";
+    }
+}
+
+
+/**
+ * @brief Executes a plan in place with the plan's butterfly algorithm.
+ *
+ * The permutation and the twiddles are read from the plan tables, so no trigonometric call
+ * happens here (and, except for the split-radix scratch buffer, no allocation).
+ * Inverse plans also apply the 1/N scaling.
+ *
+ * @param plan Plan created for a power-of-2 size.
+ * @param data Pointer to plan.N complex numbers. The transformed data will be stored back in place.
+ */
+template <typename T>
+void executePlan(const FFTPlanT<T>& plan, std::complex<T>* data) {
+    int N = plan.N;
+    if (N <= 1) {
+        return;
+    }
+
+    switch (plan.algorithm) {
+        case FFTAlgorithm::Radix4:
+            radix4_execute(plan, data);
+            break;
+        case FFTAlgorithm::Radix8:
+            radix8_execute(plan, data);
+            break;
+        case FFTAlgorithm::SplitRadix:
+            splitradix_execute(plan, data);
+            break;
+        default:
+            radix2_execute(plan, data);
+            break;
+    }
+
+    if (plan.inverse) {
+        for (int i = 0; i < N; i++) {
+            data[i] /= T(N);
+        }
+    }
+}
+
+
+/**
+ * @brief Executes a plan in place on a vector of size plan.N.
+ */
+template <typename T>
+void executePlan(const FFTPlanT<T>& plan, std::vector<std::complex<T>>& data) {
+    executePlan(plan, data.data());
+}
+
+
+/**
+ * @brief Frees every cached plan.
+ */
+void clearPlanCache() {
+    std::lock_guard<std::mutex> lock(plan_cache_mutex);
+    planCache<float>().clear();
+    planCache<double>().clear();
+    packTwiddleCache<float>().clear();
+    packTwiddleCache<double>().clear();
+}
+
+
+template FFTPlanT<float> createPlan<float>(int, bool, int, FFTAlgorithm);
+template FFTPlanT<double> createPlan<double>(int, bool, int, FFTAlgorithm);
+template const FFTPlanT<float>& getPlan<float>(int, bool, int, FFTAlgorithm);
+template const FFTPlanT<double>& getPlan<double>(int, bool, int, FFTAlgorithm);
+template const std::vector<std::complex<float>>& getPackTwiddles<float>(int);
+template const std::vector<std::complex<double>>& getPackTwiddles<double>(int);
+template void executePlan<float>(const FFTPlanT<float>&, std::complex<float>*);
+template void executePlan<double>(const FFTPlanT<double>&, std::complex<double>*);
+template void executePlan<float>(const FFTPlanT<float>&, std::vector<std::complex<float>>&);
+template void executePlan<double>(const FFTPlanT<double>&, std::vector<std::complex<double>>&);
@@ -0,0 +1,57 @@
+#ifndef FFT_PLAN_H
+#define FFT_PLAN_H
+
+#include <complex>
+#include <vector>
+
+/**
+ * @brief Butterfly algorithm used by executePlan for power-of-2 sizes.
+ *
+ * Radix4 and Radix8 merge 2 and 3 radix-2 stages into one pass over memory; SplitRadix uses
+ * the split-radix decomposition, which has the lowest flop count of the four.
+ */
+enum class FFTAlgorithm { Radix2, Radix4, Radix8, SplitRadix };
+
+/**
+ * @brief Precomputed tables for transforms of one size, direction, thread count and algorithm,
+ * in the precision T (float or double). The tables are always computed in double and rounded.
+ *
+ * twiddle[k] = exp(-2iπk/N) for a forward plan and exp(+2iπk/N) for an inverse plan, for every k < N.
+ * bitrev[i] is the bit reversal of i over log2(N) bits (empty when N is not a power of 2).
+ * block_sequence is the block permutation used by the parallel versions for num_threads blocks
+ * (only filled when num_threads is a power of 2).
+ * stage_twiddle_re/im hold, for each radix-2 stage of length len, the len/2 twiddles
+ * exp(∓2iπj/len) contiguously from offset len/2 - 1, in split real/imaginary arrays for the SIMD kernels.
+ */
+template <typename T>
+struct FFTPlanT {
+    int N;
+    bool inverse;
+    int num_threads;
+    FFTAlgorithm algorithm;
+    std::vector<std::complex<T>> twiddle;
+    std::vector<int> bitrev;
+    std::vector<int> block_sequence;
+    std::vector<T> stage_twiddle_re;
+    std::vector<T> stage_twiddle_im;
+};
+
+using FFTPlan = FFTPlanT<double>;
+using FFTPlanF = FFTPlanT<float>;
+
+// Defined in fft_plan.cpp, instantiated for float and double
+template <typename T = double>
+FFTPlanT<T> createPlan(int N, bool inverse, int num_threads, FFTAlgorithm algorithm = FFTAlgorithm::Radix2);
+template <typename T = double>
+const FFTPlanT<T>& getPlan(int N, bool inverse, int num_threads, FFTAlgorithm algorithm = FFTAlgorithm::Radix2);
+template <typename T = double>
+const std::vector<std::complex<T>>& getPackTwiddles(int N);
+template <typename T>
+void executePlan(const FFTPlanT<T>& plan, std::complex<T>* data);
+template <typename T>
+void executePlan(const FFTPlanT<T>& plan, std::vector<std::complex<T>>& data);
+
+const char* algorithmName(FFTAlgorithm algorithm);
+void clearPlanCache();
+
+#endif
@@ -0,0 +1,270 @@
+#include <complex>
+#include <vector>
+#include <utility>
+
+#include "fft_radix.h"
+
+
+/**
+ * @brief Multiplies z by -i for a forward plan and by +i for an inverse plan.
+ */
+template <typename T>
+static inline std::complex<T> rotate(const std::complex<T>& z, bool inverse) {
+    return inverse ? std::complex<T>(-z.imag(), z.real()) : std::complex<T>(z.imag(), -z.real());
+}
+
+
+/**
+ * @brief Reorders data with the bit reversal table of the plan.
+ */
+template <typename T>
+static void bitReverse(const FFTPlanT<T>& plan, std::complex<T>* data) {
+    for (int i = 0; i < plan.N; i++) {
+        int j = plan.bitrev[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+}
+
+
+/**
+ * @brief One radix-2 stage: merges pairs of DFTs of length len/2 into DFTs of length len.
+ */
+template <typename T>
+static void radix2_stage(const FFTPlanT<T>& plan, std::complex<T>* data, int len) {
+    int N = plan.N;
+    int half = len / 2;
+    int stride = N / len;
+    for (int begin = 0; begin < N; begin += len) {
+        for (int j = 0; j < half; j++) {
+            std::complex<T> u = data[begin + j];
+            std::complex<T> t = plan.twiddle[j * stride] * data[begin + j + half];
+            data[begin + j] = u + t;
+            data[begin + j + half] = u - t;
+        }
+    }
+}
+
+
+/**
+ * @brief One radix-4 stage: merges groups of 4 DFTs of length len/4 into DFTs of length len.
+ *
+ * With the input in bit-reversed order, the quarters of a block hold the DFTs of the samples
+ * congruent to 0, 2, 1 and 3 modulo 4, so the twiddle exponents are 0, 2k, k and 3k.
+ */
+template <typename T>
+static void radix4_stage(const FFTPlanT<T>& plan, std::complex<T>* data, int len) {
+    int N = plan.N;
+    int quarter = len / 4;
+    int stride = N / len;
+    for (int begin = 0; begin < N; begin += len) {
+        std::complex<T>* block = data + begin;
+        for (int k = 0; k < quarter; k++) {
+            std::complex<T> a = block[k];
+            std::complex<T> b = plan.twiddle[2 * k * stride] * block[k + quarter];
+            std::complex<T> c = plan.twiddle[k * stride] * block[k + 2 * quarter];
+            std::complex<T> d = plan.twiddle[3 * k * stride] * block[k + 3 * quarter];
+
+            std::complex<T> sum_ab = a + b;
+            std::complex<T> diff_ab = a - b;
+            std::complex<T> sum_cd = c + d;
+            std::complex<T> rot_cd = rotate(c - d, plan.inverse);
+
+            block[k] = sum_ab + sum_cd;
+            block[k + quarter] = diff_ab + rot_cd;
+            block[k + 2 * quarter] = sum_ab - sum_cd;
+            block[k + 3 * quarter] = diff_ab - rot_cd;
+        }
+    }
+}
+
+
+/**
+ * @brief One radix-8 stage: merges groups of 8 DFTs of length len/8 into DFTs of length len.
+ *
+ * Part q of a block holds the DFT of the samples congruent to bitrev3(q) modulo 8. After the
+ * twiddle w^(bitrev3(q) k), the 8 values are the bit-reversed input of an 8-point DFT, which
+ * is done in registers with three radix-2 steps.
+ */
+template <typename T>
+static void radix8_stage(const FFTPlanT<T>& plan, std::complex<T>* data, int len) {
+    int N = plan.N;
+    int eighth = len / 8;
+    int stride = N / len;
+    const std::complex<T> w8 = plan.twiddle[N / 8];
+    const std::complex<T> w8_3 = plan.twiddle[3 * N / 8];
+
+    for (int begin = 0; begin < N; begin += len) {
+        std::complex<T>* block = data + begin;
+        for (int k = 0; k < eighth; k++) {
+            const std::complex<T>* w = plan.twiddle.data();
+            int s = k * stride;
+            std::complex<T> v[8];
+            v[0] = block[k];
+            v[1] = w[4 * s] * block[k + eighth];
+            v[2] = w[2 * s] * block[k + 2 * eighth];
+            v[3] = w[6 * s] * block[k + 3 * eighth];
+            v[4] = w[s] * block[k + 4 * eighth];
+            v[5] = w[5 * s] * block[k + 5 * eighth];
+            v[6] = w[3 * s] * block[k + 6 * eighth];
+            v[7] = w[7 * s] * block[k + 7 * eighth];
+
+            // 2-point DFTs
+            for (int q = 0; q < 8; q += 2) {
+                std::complex<T> t = v[q + 1];
+                v[q + 1] = v[q] - t;
+                v[q] += t;
+            }
+            // 4-point DFTs (twiddles 1, -i)
+            for (int q = 0; q < 8; q += 4) {
+                std::complex<T> t0 = v[q + 2];
+                std::complex<T> t1 = rotate(v[q + 3], plan.inverse);
+                v[q + 2] = v[q] - t0;
+                v[q] += t0;
+                v[q + 3] = v[q + 1] - t1;
+                v[q + 1] += t1;
+            }
+            // 8-point DFT (twiddles 1, w8, -i, w8^3)
+            std::complex<T> t0 = v[4];
+            std::complex<T> t1 = w8 * v[5];
+            std::complex<T> t2 = rotate(v[6], plan.inverse);
+            std::complex<T> t3 = w8_3 * v[7];
+
+            block[k] = v[0] + t0;
+            block[k + 4 * eighth] = v[0] - t0;
+            block[k + eighth] = v[1] + t1;
+            block[k + 5 * eighth] = v[1] - t1;
+            block[k + 2 * eighth] = v[2] + t2;
+            block[k + 6 * eighth] = v[2] - t2;
+            block[k + 3 * eighth] = v[3] + t3;
+            block[k + 7 * eighth] = v[3] - t3;
+        }
+    }
+}
+
+
+static int log2Size(int N) {
+    int log2N = 0;
+    while ((1 << log2N) < N) {
+        log2N++;
+    }
+    return log2N;
+}
+
+
+/**
+ * @brief Iterative radix-2 Cooley-Tukey: bit reversal followed by log2(N) butterfly stages.
+ */
+template <typename T>
+void radix2_execute(const FFTPlanT<T>& plan, std::complex<T>* data) {
+    bitReverse(plan, data);
+    for (int len = 2; len <= plan.N; len <<= 1) {
+        radix2_stage(plan, data, len);
+    }
+}
+
+
+/**
+ * @brief Iterative radix-4: bit reversal, one radix-2 stage when log2(N) is odd, then radix-4 stages.
+ */
+template <typename T>
+void radix4_execute(const FFTPlanT<T>& plan, std::complex<T>* data) {
+    bitReverse(plan, data);
+
+    int len = 1;
+    if (log2Size(plan.N) % 2 == 1) {
+        radix2_stage(plan, data, 2);
+        len = 2;
+    }
+    for (len *= 4; len <= plan.N; len *= 4) {
+        radix4_stage(plan, data, len);
+    }
+}
+
+
+/**
+ * @brief Iterative radix-8: bit reversal, one radix-2 or radix-4 stage for the remaining
+ * log2(N) mod 3 levels, then radix-8 stages.
+ */
+template <typename T>
+void radix8_execute(const FFTPlanT<T>& plan, std::complex<T>* data) {
+    bitReverse(plan, data);
+
+    int len = 1;
+    int remainder = log2Size(plan.N) % 3;
+    if (remainder == 1) {
+        radix2_stage(plan, data, 2);
+        len = 2;
+    } else if (remainder == 2) {
+        radix4_stage(plan, data, 4);
+        len = 4;
+    }
+    for (len *= 8; len <= plan.N; len *= 8) {
+        radix8_stage(plan, data, len);
+    }
+}
+
+
+/**
+ * @brief Recursive split-radix DFT of n points read with a stride, written contiguously to out.
+ *
+ * X = U + W^k Z + W^3k Z' where U is the DFT of the even samples (length n/2) and Z, Z' are
+ * the DFTs of the samples congruent to 1 and 3 modulo 4 (length n/4).
+ */
+template <typename T>
+static void splitradix(const FFTPlanT<T>& plan, const std::complex<T>* in, int stride, std::complex<T>* out, int n) {
+    if (n == 1) {
+        out[0] = in[0];
+        return;
+    }
+    if (n == 2) {
+        out[0] = in[0] + in[stride];
+        out[1] = in[0] - in[stride];
+        return;
+    }
+
+    int half = n / 2;
+    int quarter = n / 4;
+    splitradix(plan, in, 2 * stride, out, half);
+    splitradix(plan, in + stride, 4 * stride, out + half, quarter);
+    splitradix(plan, in + 3 * stride, 4 * stride, out + half + quarter, quarter);
+
+    int tw_stride = plan.N / n;
+    for (int k = 0; k < quarter; k++) {
+        std::complex<T> a = plan.twiddle[k * tw_stride] * out[half + k];
+        std::complex<T> b = plan.twiddle[3 * k * tw_stride] * out[half + quarter + k];
+        std::complex<T> u0 = out[k];
+        std::complex<T> u1 = out[k + quarter];
+
+        std::complex<T> sum = a + b;
+        std::complex<T> rot = rotate(a - b, plan.inverse);
+
+        out[k] = u0 + sum;
+        out[k + half] = u0 - sum;
+        out[k + quarter] = u1 + rot;
+        out[k + half + quarter] = u1 - rot;
+    }
+}
+
+
+/**
+ * @brief Split-radix transform. The input is copied to a per-thread scratch buffer and the
+ * recursion writes the result straight into data, so no bit reversal pass is needed.
+ */
+template <typename T>
+void splitradix_execute(const FFTPlanT<T>& plan, std::complex<T>* data) {
+    thread_local std::vector<std::complex<T>> scratch;
+    scratch.assign(data, data + plan.N);
+    splitradix(plan, scratch.data(), 1, data, plan.N);
+}
+
+
+template void radix2_execute<float>(const FFTPlanT<float>&, std::complex<float>*);
+template void radix2_execute<double>(const FFTPlanT<double>&, std::complex<double>*);
+template void radix4_execute<float>(const FFTPlanT<float>&, std::complex<float>*);
+template void radix4_execute<double>(const FFTPlanT<double>&, std::complex<double>*);
+template void radix8_execute<float>(const FFTPlanT<float>&, std::complex<float>*);
+template void radix8_execute<double>(const FFTPlanT<double>&, std::complex<double>*);
+template void splitradix_execute<float>(const FFTPlanT<float>&, std::complex<float>*);
+template void splitradix_execute<double>(const FFTPlanT<double>&, std::complex<double>*);
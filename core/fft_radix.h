@@ -0,0 +1,18 @@
+#ifndef FFT_RADIX_H
+#define FFT_RADIX_H
+
+#include <complex>
+
+#include "fft_plan.h"
+
+// Defined in fft_radix.cpp, instantiated for float and double
+template <typename T>
+void radix2_execute(const FFTPlanT<T>& plan, std::complex<T>* data);
+template <typename T>
+void radix4_execute(const FFTPlanT<T>& plan, std::complex<T>* data);
+template <typename T>
+void radix8_execute(const FFTPlanT<T>& plan, std::complex<T>* data);
+template <typename T>
+void splitradix_execute(const FFTPlanT<T>& plan, std::complex<T>* data);
+
+#endif
@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "profiler.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_BLUE "\033[34m"
+#define COLOR_ORANGE "\033[38;5;208m"
+
+static const int NUM_COUNTERS = 3;
+static const char* const counter_names[NUM_COUNTERS] = {"cycles", "instructions", "cache_misses"};
+
+
+/**
+ * @brief One completed stage on one thread; counters are zero when they are not read.
+ */
+struct StageEvent {
+    const char* name;
+    int64_t start_ns;
+    int64_t duration_ns;
+    uint64_t counters[NUM_COUNTERS];
+};
+
+
+/**
+ * @brief Events of one thread. Only the owning thread appends to them, so recording takes no lock.
+ *
+ * Profiles are never freed, as each thread keeps a pointer to its own; the events of a thread
+ * that has exited (e.g. a replaced thread pool) stay in the report. The counter group
+ * (perf_fds[0] is its leader) is closed by profilerStop, or when the registry is destroyed.
+ */
+struct ThreadProfile {
+    int id;
+    std::vector<StageEvent> events;
+    int perf_fds[NUM_COUNTERS] = {-1, -1, -1};
+    bool counters_tried = false;
+    bool has_counters = false; // the counters were read during the last session
+
+    void closeCounters() {
+#ifdef __linux__
+        for (int& fd : perf_fds) {
+            if (fd >= 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+#endif
+    }
+
+    ~ThreadProfile() {
+        closeCounters();
+    }
+};
+
+static std::atomic<bool> recording{false};
+static std::atomic<bool> use_counters{false};
+static std::mutex registry_mutex;
+static std::vector<std::unique_ptr<ThreadProfile>> registry;
+static std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+static thread_local ThreadProfile* thread_profile = nullptr;
+
+
+static int64_t elapsedNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+
+static ThreadProfile& threadProfile() {
+    if (thread_profile == nullptr) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        registry.push_back(std::make_unique<ThreadProfile>());
+        registry.back()->id = registry.size() - 1;
+        thread_profile = registry.back().get();
+    }
+    return *thread_profile;
+}
+
+
+#ifdef __linux__
+/**
+ * @brief Opens the cycles / instructions / cache-misses group of the calling thread (user space only).
+ *
+ * Fails quietly (perf_fds stay -1) when the kernel refuses, e.g. in containers or with a high
+ * perf_event_paranoid; the stages are then only timed.
+ */
+static void openCounters(ThreadProfile& profile) {
+    static const uint64_t configs[NUM_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    int* fds = profile.perf_fds;
+
+    for (int c = 0; c < NUM_COUNTERS; c++) {
+        perf_event_attr attr = {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[c];
+        attr.disabled = c == 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        fds[c] = syscall(__NR_perf_event_open, &attr, 0, -1, c == 0 ? -1 : fds[0], 0);
+        if (fds[c] < 0) {
+            profile.closeCounters();
+            return;
+        }
+    }
+
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    profile.has_counters = true;
+}
+
+
+static void readCounters(const ThreadProfile& profile, uint64_t* counters) {
+    struct {
+        uint64_t nr;
+        uint64_t values[NUM_COUNTERS];
+    } group;
+
+    if (read(profile.perf_fds[0], &group, sizeof(group)) == (ssize_t) sizeof(group)) {
+        std::copy(group.values, group.values + NUM_COUNTERS, counters);
+    } else {
+        std::fill(counters, counters + NUM_COUNTERS, 0);
+    }
+}
+#else
+static void openCounters(ThreadProfile&) {}
+static void readCounters(const ThreadProfile&, uint64_t* counters) {
+    std::fill(counters, counters + NUM_COUNTERS, 0);
+}
+#endif
+
+
+ProfileScope::ProfileScope(const char* name) : name(name), active(recording.load(std::memory_order_relaxed)) {
+    if (!active) {
+        return;
+    }
+
+    ThreadProfile& profile = threadProfile();
+    if (use_counters && !profile.counters_tried) {
+        profile.counters_tried = true;
+        openCounters(profile);
+    }
+
+    if (use_counters && profile.perf_fds[0] >= 0) {
+        readCounters(profile, start_counters);
+    }
+    start_ns = elapsedNanoseconds();
+}
+
+
+ProfileScope::~ProfileScope() {
+    if (!active) {
+        return;
+    }
+
+    int64_t end_ns = elapsedNanoseconds();
+    ThreadProfile& profile = *thread_profile;
+
+    StageEvent event = {name, start_ns, end_ns - start_ns, {0, 0, 0}};
+    if (use_counters && profile.perf_fds[0] >= 0) {
+        readCounters(profile, event.counters);
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+            event.counters[c] -= start_counters[c];
+        }
+    }
+    profile.events.push_back(event);
+}
+
+
+/**
+ * @brief Tells whether the stage timers were compiled in (-DFFT_PROFILE).
+ */
+bool profilerCompiled() {
+#ifdef FFT_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+/**
+ * @brief Clears the recorded stages and starts recording.
+ *
+ * Must be called while no transform is running.
+ *
+ * @param hardware_counters Also read cycles, instructions and cache misses with perf_event_open.
+ * @return false if the stage timers are compiled out.
+ */
+bool profilerStart(bool hardware_counters) {
+    if (!profilerCompiled()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto& profile : registry) {
+        profile->events.clear();
+        profile->counters_tried = false;
+        profile->has_counters = false;
+    }
+    use_counters = hardware_counters;
+    recording = true;
+    return true;
+}
+
+
+/**
+ * @brief Stops recording and closes the counter groups; the recorded stages stay for the report.
+ *
+ * Must be called while no transform is running.
+ */
+void profilerStop() {
+    recording = false;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto& profile : registry) {
+        profile->closeCounters();
+    }
+}
+
+
+/**
+ * @brief Prints, for each thread and stage, the number of calls and the total time (inclusive
+ * of nested stages), with the counters and instructions per cycle when they were read.
+ *
+ * Must be called while no transform is running.
+ */
+void profilerReport(std::ostream& out) {
+    if (!profilerCompiled()) {
+        out << COLOR_ORANGE "[Profile] " COLOR_RESET << "Stage timers are compiled out, rebuild with make PROFILE=1" << std::endl;
+        return;
+    }
+
+    struct StageTotal {
+        long calls = 0;
+        int64_t nanoseconds = 0;
+        uint64_t counters[NUM_COUNTERS] = {0, 0, 0};
+    };
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    bool any_counters = false;
+    for (const auto& profile : registry) {
+        any_counters = any_counters || profile->has_counters;
+    }
+    if (use_counters && !any_counters) {
+        out << COLOR_ORANGE "[Profile] " COLOR_RESET << "Hardware counters unavailable (perf_event_open refused), showing times only" << std::endl;
+    }
+
+    out << std::fixed;
+    for (const auto& profile : registry) {
+        if (profile->events.empty()) {
+            continue;
+        }
+
+        std::map<std::string, StageTotal> totals;
+        for (const StageEvent& event : profile->events) {
+            StageTotal& total = totals[event.name];
+            total.calls++;
+            total.nanoseconds += event.duration_ns;
+            for (int c = 0; c < NUM_COUNTERS; c++) {
+                total.counters[c] += event.counters[c];
+            }
+        }
+
+        out << COLOR_BLUE "[Profile] " COLOR_RESET << "Thread " << profile->id << std::endl;
+        for (const auto& entry : totals) {
+            const StageTotal& total = entry.second;
+            out << "    " << std::left << std::setw(16) << entry.first << std::right << std::setw(7) << total.calls << " calls "
+                << std::setprecision(3) << std::setw(12) << total.nanoseconds / 1e6 << " ms";
+            if (use_counters && profile->has_counters) {
+                double ipc = total.counters[0] > 0 ? (double) total.counters[1] / total.counters[0] : 0.0;
+                out << std::setw(14) << total.counters[0] << " cycles " << std::setw(14) << total.counters[1] << " instr "
+                    << std::setprecision(2) << std::setw(6) << ipc << " IPC " << std::setw(11) << total.counters[2] << " cache misses";
+            }
+            out << std::endl;
+        }
+    }
+    out << std::defaultfloat;
+}
+
+
+/**
+ * @brief Writes the recorded stages as a Chrome trace (chrome://tracing, Perfetto), one track
+ * per thread, with the counters as event arguments.
+ *
+ * @return false if the file could not be written or the stage timers are compiled out.
+ */
+bool profilerWriteTrace(const std::string& filename) {
+    if (!profilerCompiled()) {
+        return false;
+    }
+
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\": [\n";
+    bool first = true;
+    for (const auto& profile : registry) {
+        if (profile->events.empty()) {
+            continue;
+        }
+        file << (first ? "" : ",\n") << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << profile->id
+             << ", \"args\": {\"name\": \"thread " << profile->id << "\"}}";
+        first = false;
+
+        for (const StageEvent& event : profile->events) {
+            file << ",\n  {\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << profile->id
+                 << ", \"ts\": " << event.start_ns / 1e3 << ", \"dur\": " << event.duration_ns / 1e3;
+            if (use_counters && profile->has_counters) {
+                file << ", \"args\": {";
+                for (int c = 0; c < NUM_COUNTERS; c++) {
+                    file << (c ? ", " : "") << "\"" << counter_names[c] << "\": " << event.counters[c];
+                }
+                file << "}";
+            }
+            file << "}";
+        }
+    }
+    file << "\n], \"displayTimeUnit\": \"ns\"}\n";
+    return (bool) file;
+}
@@ -0,0 +1,47 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Scoped stage timers for the hot paths of the parallel transforms.
+ *
+ * PROFILE_STAGE("name") times the rest of the enclosing block on the calling thread. It only
+ * exists in builds compiled with -DFFT_PROFILE (make PROFILE=1); otherwise it expands to nothing
+ * and the profiler functions below just report that profiling is compiled out.
+ * Recording starts with profilerStart(), which can also read the cycles, instructions and cache
+ * misses of each stage through Linux perf_event_open when the kernel allows it.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    bool active;
+    int64_t start_ns;
+    uint64_t start_counters[3];
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef FFT_PROFILE
+#define PROFILE_STAGE(name) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#else
+#define PROFILE_STAGE(name) ((void) 0)
+#endif
+
+bool profilerCompiled();
+bool profilerStart(bool hardware_counters);
+void profilerStop();
+void profilerReport(std::ostream& out);
+bool profilerWriteTrace(const std::string& filename);
+
+#endif
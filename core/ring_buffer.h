@@ -0,0 +1,88 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Lock-free bounded queue for exactly one producer thread and one consumer thread.
+ *
+ * The capacity is rounded up to a power of 2 so that positions wrap with a mask. The producer
+ * only writes tail and the consumer only writes head, each on its own cache line; an acquire
+ * load of the other index is enough to see the values published before it moved.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffer.resize(size);
+        mask = size - 1;
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    size_t capacity() const {
+        return buffer.size();
+    }
+
+    /**
+     * @brief Producer side: copies up to count values into the buffer without blocking.
+     * @return The number of values actually written (0 when the buffer is full).
+     */
+    size_t push(const T* values, size_t count) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t h = head.load(std::memory_order_acquire);
+        size_t free_slots = buffer.size() - (t - h);
+        size_t n = count < free_slots ? count : free_slots;
+        for (size_t i = 0; i < n; i++) {
+            buffer[(t + i) & mask] = values[i];
+        }
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Consumer side: moves up to count values out of the buffer without blocking.
+     * @return The number of values actually read (0 when the buffer is empty).
+     */
+    size_t pop(T* values, size_t count) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t t = tail.load(std::memory_order_acquire);
+        size_t available = t - h;
+        size_t n = count < available ? count : available;
+        for (size_t i = 0; i < n; i++) {
+            values[i] = buffer[(h + i) & mask];
+        }
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * @brief Producer side: marks the end of the stream.
+     */
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer side: true once the producer has closed the stream and every value was read.
+     */
+    bool finished() const {
+        return closed.load(std::memory_order_acquire) && head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> buffer;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    std::atomic<bool> closed{false};
+};
+
+#endif
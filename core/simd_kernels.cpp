@@ -0,0 +1,190 @@
+#include <cstdlib>
+#include <cstring>
+
+#include "simd_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FFT_X86 1
+#endif
+
+
+// Each kernel runs one radix-2 stage (all blocks of length 2 * half) over split real/imaginary
+// arrays that are already in bit-reversed order. wr/wi point to the half twiddles of the stage.
+typedef void (*StageKernel)(double* re, double* im, int N, int half, const double* wr, const double* wi);
+
+
+static void stage_scalar(double* re, double* im, int N, int half, const double* wr, const double* wi) {
+    for (int begin = 0; begin < N; begin += 2 * half) {
+        double* ur = re + begin;
+        double* ui = im + begin;
+        double* vr = ur + half;
+        double* vi = ui + half;
+        for (int j = 0; j < half; j++) {
+            double tr = vr[j] * wr[j] - vi[j] * wi[j];
+            double ti = vr[j] * wi[j] + vi[j] * wr[j];
+            vr[j] = ur[j] - tr;
+            vi[j] = ui[j] - ti;
+            ur[j] += tr;
+            ui[j] += ti;
+        }
+    }
+}
+
+
+#ifdef FFT_X86
+
+static void stage_sse2(double* re, double* im, int N, int half, const double* wr, const double* wi) {
+    for (int begin = 0; begin < N; begin += 2 * half) {
+        double* ur = re + begin;
+        double* ui = im + begin;
+        double* vr = ur + half;
+        double* vi = ui + half;
+        for (int j = 0; j < half; j += 2) {
+            __m128d w_r = _mm_loadu_pd(wr + j), w_i = _mm_loadu_pd(wi + j);
+            __m128d v_r = _mm_loadu_pd(vr + j), v_i = _mm_loadu_pd(vi + j);
+            __m128d u_r = _mm_loadu_pd(ur + j), u_i = _mm_loadu_pd(ui + j);
+            __m128d t_r = _mm_sub_pd(_mm_mul_pd(v_r, w_r), _mm_mul_pd(v_i, w_i));
+            __m128d t_i = _mm_add_pd(_mm_mul_pd(v_r, w_i), _mm_mul_pd(v_i, w_r));
+            _mm_storeu_pd(ur + j, _mm_add_pd(u_r, t_r));
+            _mm_storeu_pd(ui + j, _mm_add_pd(u_i, t_i));
+            _mm_storeu_pd(vr + j, _mm_sub_pd(u_r, t_r));
+            _mm_storeu_pd(vi + j, _mm_sub_pd(u_i, t_i));
+        }
+    }
+}
+
+
+__attribute__((target("avx2,fma")))
+static void stage_avx2(double* re, double* im, int N, int half, const double* wr, const double* wi) {
+    for (int begin = 0; begin < N; begin += 2 * half) {
+        double* ur = re + begin;
+        double* ui = im + begin;
+        double* vr = ur + half;
+        double* vi = ui + half;
+        for (int j = 0; j < half; j += 4) {
+            __m256d w_r = _mm256_loadu_pd(wr + j), w_i = _mm256_loadu_pd(wi + j);
+            __m256d v_r = _mm256_loadu_pd(vr + j), v_i = _mm256_loadu_pd(vi + j);
+            __m256d u_r = _mm256_loadu_pd(ur + j), u_i = _mm256_loadu_pd(ui + j);
+            __m256d t_r = _mm256_fmsub_pd(v_r, w_r, _mm256_mul_pd(v_i, w_i));
+            __m256d t_i = _mm256_fmadd_pd(v_r, w_i, _mm256_mul_pd(v_i, w_r));
+            _mm256_storeu_pd(ur + j, _mm256_add_pd(u_r, t_r));
+            _mm256_storeu_pd(ui + j, _mm256_add_pd(u_i, t_i));
+            _mm256_storeu_pd(vr + j, _mm256_sub_pd(u_r, t_r));
+            _mm256_storeu_pd(vi + j, _mm256_sub_pd(u_i, t_i));
+        }
+    }
+}
+
+
+__attribute__((target("avx512f")))
+static void stage_avx512(double* re, double* im, int N, int half, const double* wr, const double* wi) {
+    for (int begin = 0; begin < N; begin += 2 * half) {
+        double* ur = re + begin;
+        double* ui = im + begin;
+        double* vr = ur + half;
+        double* vi = ui + half;
+        for (int j = 0; j < half; j += 8) {
+            __m512d w_r = _mm512_loadu_pd(wr + j), w_i = _mm512_loadu_pd(wi + j);
+            __m512d v_r = _mm512_loadu_pd(vr + j), v_i = _mm512_loadu_pd(vi + j);
+            __m512d u_r = _mm512_loadu_pd(ur + j), u_i = _mm512_loadu_pd(ui + j);
+            __m512d t_r = _mm512_fmsub_pd(v_r, w_r, _mm512_mul_pd(v_i, w_i));
+            __m512d t_i = _mm512_fmadd_pd(v_r, w_i, _mm512_mul_pd(v_i, w_r));
+            _mm512_storeu_pd(ur + j, _mm512_add_pd(u_r, t_r));
+            _mm512_storeu_pd(ui + j, _mm512_add_pd(u_i, t_i));
+            _mm512_storeu_pd(vr + j, _mm512_sub_pd(u_r, t_r));
+            _mm512_storeu_pd(vi + j, _mm512_sub_pd(u_i, t_i));
+        }
+    }
+}
+
+#endif
+
+
+/**
+ * @brief Returns the widest instruction set supported by the CPU running the program (CPUID).
+ */
+SimdLevel detectSimdLevel() {
+#ifdef FFT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::AVX2;
+    }
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+
+/**
+ * @brief Returns the kernel level used by fft_split, chosen once per process.
+ * 
+ * Defaults to detectSimdLevel(); the FFT_SIMD environment variable (scalar, sse2, avx2 or avx512)
+ * can force a narrower level, e.g. to compare kernels on the same machine.
+ */
+SimdLevel activeSimdLevel() {
+    static const SimdLevel level = [] {
+        SimdLevel detected = detectSimdLevel();
+        const char* forced = std::getenv("FFT_SIMD");
+        if (forced == nullptr) {
+            return detected;
+        }
+
+        SimdLevel requested = detected;
+        if (std::strcmp(forced, "scalar") == 0) requested = SimdLevel::Scalar;
+        if (std::strcmp(forced, "sse2") == 0) requested = SimdLevel::SSE2;
+        if (std::strcmp(forced, "avx2") == 0) requested = SimdLevel::AVX2;
+        if (std::strcmp(forced, "avx512") == 0) requested = SimdLevel::AVX512;
+        return requested < detected ? requested : detected;
+    }();
+    return level;
+}
+
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2:
+            return "SSE2";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::AVX512:
+            return "AVX-512";
+        default:
+            return "scalar";
+    }
+}
+
+
+/**
+ * @brief Runs the log2(N) radix-2 butterfly stages over split real/imaginary arrays.
+ * 
+ * The arrays must already be in bit-reversed order. Each stage uses the widest kernel whose vector
+ * width fits in the stage's half length; the first stages (half < width) use the scalar kernel.
+ * 
+ * @param re Real parts (size N).
+ * @param im Imaginary parts (size N).
+ * @param N Size of the transform (a power of 2).
+ * @param twiddle_re Per-stage twiddle table (FFTPlan::stage_twiddle_re).
+ * @param twiddle_im Per-stage twiddle table (FFTPlan::stage_twiddle_im).
+ */
+void fft_split(double* re, double* im, int N, const double* twiddle_re, const double* twiddle_im) {
+    SimdLevel level = activeSimdLevel();
+
+    for (int half = 1; half < N; half <<= 1) {
+        StageKernel kernel = stage_scalar;
+#ifdef FFT_X86
+        if (level >= SimdLevel::AVX512 && half >= 8) {
+            kernel = stage_avx512;
+        } else if (level >= SimdLevel::AVX2 && half >= 4) {
+            kernel = stage_avx2;
+        } else if (level >= SimdLevel::SSE2 && half >= 2) {
+            kernel = stage_sse2;
+        }
+#endif
+        kernel(re, im, N, half, twiddle_re + half - 1, twiddle_im + half - 1);
+    }
+}
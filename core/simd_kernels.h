@@ -0,0 +1,11 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512 };
+
+SimdLevel detectSimdLevel();
+SimdLevel activeSimdLevel();
+const char* simdLevelName(SimdLevel level);
+void fft_split(double* re, double* im, int N, const double* twiddle_re, const double* twiddle_im);
+
+#endif
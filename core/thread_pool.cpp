@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.h"
+
+extern int p; // number of processors
+
+static std::unique_ptr<ThreadPool> global_pool;
+static thread_local bool inside_pool_task = false;
+
+
+/**
+ * @brief Starts num_threads - 1 worker threads that sleep until work is submitted.
+ *
+ * @param num_threads Number of threads taking part in each run (including the caller).
+ */
+ThreadPool::ThreadPool(int num_threads) {
+    num_threads = std::max(num_threads, 1);
+    active_threads = num_threads;
+    busy_time.assign(num_threads, 0.0);
+    for (int i = 1; i < num_threads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    start_cv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+
+/**
+ * @brief Number of threads taking part in each run (see setActiveThreads).
+ */
+int ThreadPool::size() const {
+    return active_threads;
+}
+
+
+/**
+ * @brief Number of threads owned by the pool, including the caller.
+ */
+int ThreadPool::maxSize() const {
+    return workers.size() + 1;
+}
+
+
+/**
+ * @brief Limits the following runs to num_threads threads (clamped to [1, maxSize()]); the
+ * other workers keep sleeping. Must not be called from inside a pool task.
+ */
+void ThreadPool::setActiveThreads(int num_threads) {
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    active_threads = std::max(1, std::min(num_threads, maxSize()));
+}
+
+
+/**
+ * @brief Number of tasks that are guaranteed to run concurrently in a run() issued from this thread.
+ *
+ * Tasks that synchronize with a Barrier must use at most this many tasks: inside a pool task,
+ * run() executes inline, so the team shrinks to 1.
+ */
+int ThreadPool::teamSize() const {
+    return inside_pool_task ? 1 : size();
+}
+
+
+/**
+ * @brief Runs task(i) for every i in [0, num_tasks) on the pool and waits for all of them.
+ *
+ * Tasks are handed out dynamically, so num_tasks may exceed size(). The time spent waking the
+ * workers and waiting for the slowest one, beyond the longest busy thread, is recorded as dispatch overhead.
+ *
+ * @param num_tasks Number of tasks.
+ * @param task Function called with the task index.
+ */
+void ThreadPool::run(int num_tasks, const std::function<void(int)>& task) {
+    if (inside_pool_task || active_threads <= 1 || num_tasks <= 1) {
+        for (int i = 0; i < num_tasks; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    auto start = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current_task = &task;
+        this->num_tasks = num_tasks;
+        next_task = 0;
+        active_workers = active_threads - 1;
+        std::fill(busy_time.begin(), busy_time.end(), 0.0);
+        generation++;
+    }
+    start_cv.notify_all();
+
+    participate(0);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [this] { return active_workers == 0; });
+        current_task = nullptr;
+    }
+
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    double busiest = *std::max_element(busy_time.begin(), busy_time.end());
+    overhead_seconds += std::max(wall.count() - busiest, 0.0);
+    runs++;
+}
+
+
+/**
+ * @brief Splits [begin, end) into at most size() contiguous chunks and runs body(chunk_begin, chunk_end) on each.
+ */
+void ThreadPool::parallel_for(int begin, int end, const std::function<void(int, int)>& body) {
+    int length = end - begin;
+    if (length <= 0) {
+        return;
+    }
+
+    int chunks = std::min(size(), length);
+    run(chunks, [&](int i) {
+        int chunk_begin = begin + (long long) length * i / chunks;
+        int chunk_end = begin + (long long) length * (i + 1) / chunks;
+        body(chunk_begin, chunk_end);
+    });
+}
+
+
+/**
+ * @brief Total dispatch overhead (in seconds) accumulated by run() since the last resetStats().
+ */
+double ThreadPool::dispatchOverhead() const {
+    return overhead_seconds;
+}
+
+
+/**
+ * @brief Number of parallel runs dispatched since the last resetStats().
+ */
+long ThreadPool::dispatchCount() const {
+    return runs;
+}
+
+
+void ThreadPool::resetStats() {
+    overhead_seconds = 0.0;
+    runs = 0;
+}
+
+
+void ThreadPool::participate(int worker_id) {
+    inside_pool_task = true;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = next_task++; i < num_tasks; i = next_task++) {
+        (*current_task)(i);
+    }
+
+    std::chrono::duration<double> busy = std::chrono::steady_clock::now() - start;
+    busy_time[worker_id] = busy.count();
+    inside_pool_task = false;
+}
+
+
+void ThreadPool::workerLoop(int worker_id) {
+    long seen_generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_cv.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+            if (worker_id >= active_threads) {
+                continue;
+            }
+        }
+
+        participate(worker_id);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--active_workers == 0) {
+                done_cv.notify_one();
+            }
+        }
+    }
+}
+
+
+Barrier::Barrier(int count) : count(count) {}
+
+
+/**
+ * @brief Blocks until count threads have called wait() for the current generation.
+ */
+void Barrier::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    long arrival_generation = generation;
+    if (++waiting == count) {
+        waiting = 0;
+        generation++;
+        cv.notify_all();
+        return;
+    }
+    cv.wait(lock, [&] { return generation != arrival_generation; });
+}
+
+
+/**
+ * @brief Tells whether the calling thread is running a pool task (where run() executes inline).
+ */
+bool insidePoolTask() {
+    return inside_pool_task;
+}
+
+
+/**
+ * @brief (Re)creates the process-wide pool with num_threads threads. Called once from main.
+ */
+void initThreadPool(int num_threads) {
+    global_pool = std::make_unique<ThreadPool>(num_threads);
+}
+
+
+/**
+ * @brief Returns the process-wide pool, creating it with p threads if main has not done so.
+ */
+ThreadPool& getThreadPool() {
+    if (!global_pool) {
+        initThreadPool(p);
+    }
+    return *global_pool;
+}
@@ -0,0 +1,79 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Long-lived pool of worker threads with a fork-join interface.
+ *
+ * A pool of size n owns n - 1 worker threads; the thread calling run() takes part in the work,
+ * so n tasks run concurrently. A run() issued from inside a task executes inline on that thread.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const;
+    int maxSize() const;
+    void setActiveThreads(int num_threads);
+    int teamSize() const;
+    void run(int num_tasks, const std::function<void(int)>& task);
+    void parallel_for(int begin, int end, const std::function<void(int, int)>& body);
+
+    double dispatchOverhead() const;
+    long dispatchCount() const;
+    void resetStats();
+
+private:
+    void workerLoop(int worker_id);
+    void participate(int worker_id);
+
+    std::vector<std::thread> workers;
+    std::mutex run_mutex;
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+
+    const std::function<void(int)>* current_task = nullptr;
+    int num_tasks = 0;
+    int active_threads;
+    std::atomic<int> next_task{0};
+    int active_workers = 0;
+    long generation = 0;
+    bool stopping = false;
+
+    std::vector<double> busy_time;
+    double overhead_seconds = 0.0;
+    long runs = 0;
+};
+
+/**
+ * @brief Reusable barrier for the threads of one ThreadPool::run() team.
+ */
+class Barrier {
+public:
+    explicit Barrier(int count);
+    void wait();
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    int count;
+    int waiting = 0;
+    long generation = 0;
+};
+
+bool insidePoolTask();
+void initThreadPool(int num_threads);
+ThreadPool& getThreadPool();
+
+#endif
@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "binary_dataset.h"
+#include "../core/thread_pool.h"
+
+namespace fs = std::filesystem;
+
+static const char DATASET_MAGIC[8] = {'F', 'F', 'T', 'D', 'A', 'T', 'A', '1'};
+static const uint32_t DATASET_FORMAT_VERSION = 1;
+
+// Chunks handed to each thread when parsing a CSV file
+const int CSV_CHUNKS_PER_THREAD = 4;
+
+
+MappedDataset::MappedDataset(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(DatasetHeader)) {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            mapping = address;
+            mapping_size = info.st_size;
+        }
+    }
+    close(fd);
+
+    if (mapping != nullptr) {
+        const DatasetHeader& h = header();
+        size_t sample_size = h.dtype == SampleType::Complex128 ? 2 * sizeof(double) : sizeof(double);
+        bool ok = std::memcmp(h.magic, DATASET_MAGIC, sizeof(DATASET_MAGIC)) == 0
+            && h.format_version == DATASET_FORMAT_VERSION
+            && h.data_offset >= sizeof(DatasetHeader)
+            && h.data_offset + h.length * sample_size <= mapping_size;
+        if (!ok) {
+            munmap(mapping, mapping_size);
+            mapping = nullptr;
+        }
+    }
+}
+
+
+MappedDataset::~MappedDataset() {
+    if (mapping != nullptr) {
+        munmap(mapping, mapping_size);
+    }
+}
+
+
+bool MappedDataset::valid() const {
+    return mapping != nullptr;
+}
+
+
+const DatasetHeader& MappedDataset::header() const {
+    return *static_cast<const DatasetHeader*>(mapping);
+}
+
+
+/**
+ * @brief Returns the samples (interleaved real and imaginary parts for Complex128 files).
+ */
+const double* MappedDataset::samples() const {
+    return reinterpret_cast<const double*>(static_cast<const char*>(mapping) + header().data_offset);
+}
+
+
+size_t MappedDataset::length() const {
+    return header().length;
+}
+
+
+/**
+ * @brief Parses one value per line in [begin, end), skipping empty lines; unparsable lines become NaN.
+ */
+static void parseLines(const char* begin, const char* end, std::vector<double>& values) {
+    const char* line = begin;
+    while (line < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (line_end == nullptr) {
+            line_end = end;
+        }
+        const char* first = line;
+        const char* last = line_end;
+        while (first < last && (*first == ' ' || *first == '\t')) {
+            first++;
+        }
+        while (last > first && (last[-1] == '\r' || last[-1] == ' ' || last[-1] == '\t')) {
+            last--;
+        }
+        if (first < last) {
+            if (*first == '+') {
+                first++;
+            }
+            double value;
+            if (std::from_chars(first, last, value).ec != std::errc()) {
+                value = std::nan("");
+            }
+            values.push_back(value);
+        }
+        line = line_end + 1;
+    }
+}
+
+
+/**
+ * @brief Parses a CSV file with one value per line, in parallel.
+ *
+ * The file is read in one block and cut into chunks at line boundaries; the chunks are parsed
+ * with std::from_chars on the thread pool and concatenated in order.
+ *
+ * @param filename Path of the CSV file.
+ * @param nan_count Receives the number of lines that could not be parsed (stored as NaN).
+ * @return The values, or an empty vector if the file cannot be read.
+ */
+std::vector<double> parseCSV(const std::string& filename, size_t& nan_count) {
+    nan_count = 0;
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ThreadPool& pool = getThreadPool();
+    int num_chunks = std::max<size_t>(1, std::min<size_t>((size_t)pool.size() * CSV_CHUNKS_PER_THREAD, text.size() / 4096 + 1));
+    std::vector<size_t> bounds(num_chunks + 1, text.size());
+    bounds[0] = 0;
+    for (int c = 1; c < num_chunks; c++) {
+        size_t position = std::max(bounds[c - 1], text.size() * c / num_chunks);
+        size_t newline = text.find('\n', position);
+        bounds[c] = newline == std::string::npos ? text.size() : newline + 1;
+    }
+
+    std::vector<std::vector<double>> chunks(num_chunks);
+    pool.parallel_for(0, num_chunks, [&](int first, int last) {
+        for (int c = first; c < last; c++) {
+            parseLines(text.data() + bounds[c], text.data() + bounds[c + 1], chunks[c]);
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size();
+    }
+    std::vector<double> values;
+    values.reserve(total);
+    for (const auto& chunk : chunks) {
+        values.insert(values.end(), chunk.begin(), chunk.end());
+    }
+    for (double value : values) {
+        if (std::isnan(value)) {
+            nan_count++;
+        }
+    }
+    return values;
+}
+
+
+/**
+ * @brief Writes real samples to a binary dataset file (header followed by the float64 values).
+ */
+bool writeBinaryDataset(const std::string& filename, const std::vector<double>& samples, size_t nan_count) {
+    DatasetHeader header = {};
+    std::memcpy(header.magic, DATASET_MAGIC, sizeof(DATASET_MAGIC));
+    header.format_version = DATASET_FORMAT_VERSION;
+    header.dtype = SampleType::Float64;
+    header.length = samples.size();
+    header.nan_count = nan_count;
+    header.data_offset = sizeof(DatasetHeader);
+
+    // Written to a temporary name first so that a concurrent run never maps a partial file
+    std::string temporary = filename + ".tmp";
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(double));
+    file.close();
+    if (!file) {
+        return false;
+    }
+    std::error_code error;
+    fs::rename(temporary, filename, error);
+    return !error;
+}
+
+
+/**
+ * @brief Returns the path of the binary file caching a CSV dataset: data/X.csv -> data/X.fftbin.
+ */
+std::string binaryDatasetPath(const std::string& csv_filename) {
+    return fs::path(csv_filename).replace_extension(".fftbin").string();
+}
+
+
+/**
+ * @brief Converts a CSV dataset to its binary file, unless the binary file is already up to date.
+ *
+ * @return False if the CSV file cannot be read or the binary file cannot be written.
+ */
+bool importDataset(const std::string& csv_filename) {
+    std::string binary = binaryDatasetPath(csv_filename);
+    std::error_code error;
+    if (fs::exists(binary, error) && fs::last_write_time(binary, error) >= fs::last_write_time(csv_filename, error) && MappedDataset(binary).valid()) {
+        return true;
+    }
+
+    size_t nan_count = 0;
+    std::vector<double> samples = parseCSV(csv_filename, nan_count);
+    if (samples.empty()) {
+        return false;
+    }
+    if (nan_count > 0) {
+        std::cerr << csv_filename << ": " << nan_count << " values could not be parsed and are stored as NaN" << std::endl;
+    }
+    return writeBinaryDataset(binary, samples, nan_count);
+}
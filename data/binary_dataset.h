@@ -0,0 +1,50 @@
+#ifndef BINARY_DATASET_H
+#define BINARY_DATASET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class SampleType : uint32_t { Float64 = 0, Complex128 = 1 };
+
+/**
+ * @brief Header of a binary dataset file (64 bytes, followed by the samples in native byte order).
+ */
+struct DatasetHeader {
+    char magic[8];
+    uint32_t format_version;
+    SampleType dtype;
+    uint64_t length;
+    uint64_t nan_count;
+    uint64_t data_offset;
+    char reserved[24];
+};
+
+/**
+ * @brief Read-only memory mapping of a binary dataset: the samples are used in place, without copy or parse.
+ */
+class MappedDataset {
+public:
+    explicit MappedDataset(const std::string& filename);
+    ~MappedDataset();
+
+    MappedDataset(const MappedDataset&) = delete;
+    MappedDataset& operator=(const MappedDataset&) = delete;
+
+    bool valid() const;
+    const DatasetHeader& header() const;
+    const double* samples() const;
+    size_t length() const;
+
+private:
+    void* mapping = nullptr;
+    size_t mapping_size = 0;
+};
+
+std::vector<double> parseCSV(const std::string& filename, size_t& nan_count);
+bool writeBinaryDataset(const std::string& filename, const std::vector<double>& samples, size_t nan_count);
+std::string binaryDatasetPath(const std::string& csv_filename);
+bool importDataset(const std::string& csv_filename);
+
+#endif
@@ -7,16 +7,23 @@
 #include <string>
 #include <algorithm>
 
-std::vector<std::complex<double>> readWeatherData(const std::string& filename) {
+#include "import_data.h"
+#include "binary_dataset.h"
+
+/**
+ * @brief Reads one temperature per line from a CSV file with std::getline and std::stod.
+ * 
+ * Only used when the binary file of the dataset cannot be written (e.g. read-only directory).
+ */
+static std::vector<double> readWeatherDataCSV(const std::string& filename) {
     std::ifstream file(filename);
     std::string line;
-    std::vector<std::complex<double>> data;
+    std::vector<double> data;
 
     if (file.is_open()) {
         while (std::getline(file, line)) {
             if (!line.empty()) {
-                double temp = std::stod(line);
-                data.push_back(std::complex<double>(temp, 0.0));
+                data.push_back(std::stod(line));
             }
         }
         file.close();
@@ -26,4 +33,43 @@ std::vector<std::complex<double>> readWeatherData(const std::string& filename) {
     }
 
     return data;
-}
\ No newline at end of file
+}
+
+
+/**
+ * @brief Reads one temperature per line from a CSV file as real values.
+ * 
+ * The temperatures are real, so this is the form used by the real-input (R2C) transforms.
+ * The CSV file is converted once to a binary file next to it (see importDataset); later runs
+ * memory-map the binary file and copy the samples straight into the vector, without parsing.
+ * 
+ * @param filename Path of the CSV file.
+ * @return The temperatures.
+ */
+std::vector<double> readWeatherDataReal(const std::string& filename) {
+    if (importDataset(filename)) {
+        MappedDataset dataset(binaryDatasetPath(filename));
+        if (dataset.valid() && dataset.header().dtype == SampleType::Float64) {
+            return std::vector<double>(dataset.samples(), dataset.samples() + dataset.length());
+        }
+    }
+    return readWeatherDataCSV(filename);
+}
+
+
+/**
+ * @brief Reads one temperature per line from a CSV file as complex values with a zero imaginary part.
+ * 
+ * @param filename Path of the CSV file.
+ * @return The temperatures.
+ */
+std::vector<std::complex<double>> readWeatherData(const std::string& filename) {
+    if (importDataset(filename)) {
+        MappedDataset dataset(binaryDatasetPath(filename));
+        if (dataset.valid() && dataset.header().dtype == SampleType::Float64) {
+            return std::vector<std::complex<double>>(dataset.samples(), dataset.samples() + dataset.length());
+        }
+    }
+    std::vector<double> temps = readWeatherDataCSV(filename);
+    return std::vector<std::complex<double>>(temps.begin(), temps.end());
+}
@@ -3,7 +3,9 @@
 
 #include <complex>
 #include <string>
+#include <vector>
 
+std::vector<double> readWeatherDataReal(const std::string& filename);
 std::vector<std::complex<double>> readWeatherData(const std::string& filename);
 
 #endif // IMPORT_DATA_H
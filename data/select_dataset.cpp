@@ -1,7 +1,10 @@
 #include "select_dataset.h"
+#include "binary_dataset.h"
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
 #include <fstream>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -23,27 +26,41 @@ void saveSelectedDataset(const std::string& dataset) {
     }
 }
 
-void listDatasets() {
-    int index = 1;
+/**
+ * @brief Returns the CSV datasets of the data directory, sorted by name so that the numbers are stable.
+ */
+static std::vector<fs::path> datasetFiles() {
+    std::vector<fs::path> files;
     for (const auto& entry : fs::directory_iterator("data")) {
         if (entry.is_regular_file() && entry.path().extension() == ".csv") {
-            std::cout << "[" << index++ << "] " << entry.path().stem().string() << std::endl;
+            files.push_back(entry.path());
         }
     }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+void listDatasets() {
+    std::vector<fs::path> files = datasetFiles();
+    for (size_t i = 0; i < files.size(); i++) {
+        std::cout << "[" << i + 1 << "] " << files[i].stem().string() << std::endl;
+    }
 }
 
+/**
+ * @brief Selects a dataset and converts it to its binary file, so that later runs do not parse the CSV.
+ */
 void selectDataset(int num) {
-    int index = 1;
-    for (const auto& entry : fs::directory_iterator("data")) {
-        if (entry.is_regular_file() && entry.path().extension() == ".csv") {
-            if (index == num) {
-                data_file = entry.path().string();
-                saveSelectedDataset(data_file);
-                std::cout << "Selected dataset: " << data_file << std::endl;
-                return;
-            }
-            index++;
-        }
+    std::vector<fs::path> files = datasetFiles();
+    if (num < 1 || num > (int)files.size()) {
+        std::cerr << "Invalid dataset number: " << num << std::endl;
+        return;
+    }
+
+    data_file = files[num - 1].string();
+    saveSelectedDataset(data_file);
+    std::cout << "Selected dataset: " << data_file << std::endl;
+    if (!importDataset(data_file)) {
+        std::cerr << "Could not convert " << data_file << " to " << binaryDatasetPath(data_file) << ", it will be parsed on every run" << std::endl;
     }
-    std::cerr << "Invalid dataset number: " << num << std::endl;
 }
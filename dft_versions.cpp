@@ -0,0 +1,338 @@
+#include <complex>
+#include <string>
+#include <vector>
+
+#include "parallel_dft/parallel_DFT_V0.h"
+#include "parallel_dft/parallel_DFT_V1.h"
+#include "parallel_dft/parallel_DFT_V2.h"
+#include "parallel_dft/parallel_DFT_mixed.h"
+#include "parallel_dft/parallel_DFT_sixstep.h"
+#include "sequential_dft/sequential_DFT_V1.h"
+#include "sequential_dft/sequential_DFT_V2.h"
+#include "sequential_dft/sequential_DFT_V3.h"
+#include "sequential_dft/sequential_DFT_mixed.h"
+#include "sequential_dft/sequential_DFT_radix.h"
+#include "sequential_dft/sequential_DFT_simd.h"
+
+#include "dft_versions.h"
+#include "autotune.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_BLUE "\033[34m"
+
+// Version numbers accepted on the command line:
+//   sequential: 1 = definition, 2 = recursive radix-2, 3 = iterative radix-2, 4 = mixed radix,
+//               5 = iterative radix-2 with SIMD kernels, 6 = radix-4, 7 = radix-8, 8 = split-radix
+//   parallel:   0 = definition, 1 = radix-2 blocks, 2 = radix-2 blocks with precomputed twiddles, 3 = mixed radix,
+//               4 = six-step with cache-blocked transposes
+//   both:       auto (AUTO_VERSION) = fastest plan in the wisdom file
+//               ntt (NTT_VERSION) = multiplication only, exact integer product modulo NTT primes
+
+
+bool isPowerOfTwo(int N) {
+    return N > 0 && (N & (N - 1)) == 0;
+}
+
+
+bool isValidVersion(bool parallel, int version) {
+    if (version == AUTO_VERSION) {
+        return true;
+    }
+    if (parallel) {
+        return version >= 0 && version <= 4;
+    }
+    return version >= 1 && version <= 8;
+}
+
+
+/**
+ * @brief Returns the versions available for a mode, e.g. "{0, 1, 2, 3, 4}", for error messages.
+ */
+std::string versionList(bool parallel) {
+    return parallel ? "{0, 1, 2, 3, 4, auto}" : "{1, 2, 3, 4, 5, 6, 7, 8, auto}";
+}
+
+
+/**
+ * @brief Returns the version as written on the command line: its number, "auto" or "ntt".
+ */
+std::string versionName(int version) {
+    if (version == AUTO_VERSION) {
+        return "auto";
+    }
+    return version == NTT_VERSION ? "ntt" : std::to_string(version);
+}
+
+
+/**
+ * @brief Returns the colored prefix used in the outputs, e.g. "[Parallel V2] ".
+ */
+std::string versionLabel(bool parallel, int version) {
+    std::string mode = parallel ? "Parallel" : "Sequential";
+    return COLOR_BLUE "[" + mode + " V" + versionName(version) + "] " COLOR_RESET;
+}
+
+
+/**
+ * @brief Returns the version that can actually transform N points.
+ * 
+ * The radix-2 versions only handle powers of 2; for any other N they are replaced by the
+ * mixed-radix version of the same mode, so the data never has to be padded.
+ */
+int resolveVersion(int N, bool parallel, int version) {
+    if (isPowerOfTwo(N)) {
+        return version;
+    }
+    if (!parallel && (version == 2 || version == 3 || version >= 5)) {
+        return 4;
+    }
+    if (parallel && (version == 1 || version == 2 || version == 4)) {
+        return 3;
+    }
+    return version;
+}
+
+
+/**
+ * @brief Runs the forward DFT of the given mode and version in place.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm to use (see resolveVersion for non power-of-2 sizes).
+ */
+void forwardDFT(std::vector<std::complex<double>>& data, bool parallel, int version) {
+    int N = data.size();
+
+    if (version == AUTO_VERSION) {
+        autoDFT(data, parallel, false);
+        return;
+    }
+
+    if (!parallel) {
+        switch (version) {
+            case 1:
+                DFT_V1(data, N);
+                break;
+            case 2:
+                DFT_V2(data, N);
+                break;
+            case 3:
+                DFT_V3(data, N);
+                break;
+            case 4:
+                DFT_mixed(data, N);
+                break;
+            case 5:
+                DFT_simd(data, N);
+                break;
+            case 6:
+                DFT_radix(data, N, FFTAlgorithm::Radix4);
+                break;
+            case 7:
+                DFT_radix(data, N, FFTAlgorithm::Radix8);
+                break;
+            case 8:
+                DFT_radix(data, N, FFTAlgorithm::SplitRadix);
+                break;
+        }
+    } else {
+        switch (version) {
+            case 0:
+                DFT_parallel_V0(data);
+                break;
+            case 1:
+                DFT_parallel_V1(data);
+                break;
+            case 2:
+                DFT_parallel_V2(data);
+                break;
+            case 3:
+                DFT_parallel_mixed(data);
+                break;
+            case 4:
+                DFT_parallel_sixstep(data);
+                break;
+        }
+    }
+}
+
+
+/**
+ * @brief Runs the inverse DFT of the given mode and version in place.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm to use.
+ */
+void inverseDFT(std::vector<std::complex<double>>& data, bool parallel, int version) {
+    if (version == AUTO_VERSION) {
+        autoDFT(data, parallel, true);
+        return;
+    }
+
+    if (!parallel) {
+        switch (version) {
+            case 1:
+                invDFT_V1(data);
+                break;
+            case 2:
+                invDFT_V2(data);
+                break;
+            case 3:
+                invDFT_V3(data);
+                break;
+            case 4:
+                invDFT_mixed(data);
+                break;
+            case 5:
+                invDFT_simd(data);
+                break;
+            case 6:
+                invDFT_radix(data, FFTAlgorithm::Radix4);
+                break;
+            case 7:
+                invDFT_radix(data, FFTAlgorithm::Radix8);
+                break;
+            case 8:
+                invDFT_radix(data, FFTAlgorithm::SplitRadix);
+                break;
+        }
+    } else {
+        switch (version) {
+            case 0:
+                invDFT_parallel_V0(data);
+                break;
+            case 1:
+                invDFT_parallel_V1(data);
+                break;
+            case 2:
+                invDFT_parallel_V2(data);
+                break;
+            case 3:
+                invDFT_parallel_mixed(data);
+                break;
+            case 4:
+                invDFT_parallel_sixstep(data);
+                break;
+        }
+    }
+}
+
+
+/**
+ * @brief Returns true if the version has a single-precision engine.
+ *
+ * The other versions run in double precision when they are given float data (see forwardDFT).
+ */
+bool hasFloatEngine(bool parallel, int version) {
+    if (parallel) {
+        return version == 2 || version == 4;
+    }
+    return version == 1 || version == 2 || version == 3 || version >= 6;
+}
+
+
+/**
+ * @brief Runs a double-precision transform on float data, for the versions without a float engine.
+ */
+static void transformInDouble(std::vector<std::complex<float>>& data, bool parallel, int version, bool inverse) {
+    std::vector<std::complex<double>> wide(data.begin(), data.end());
+    if (inverse) {
+        inverseDFT(wide, parallel, version);
+    } else {
+        forwardDFT(wide, parallel, version);
+    }
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = std::complex<float>(wide[i]);
+    }
+}
+
+
+/**
+ * @brief Runs the forward DFT of the given mode and version in place, in single precision.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm to use (see hasFloatEngine).
+ */
+void forwardDFT(std::vector<std::complex<float>>& data, bool parallel, int version) {
+    int N = data.size();
+
+    if (!hasFloatEngine(parallel, version)) {
+        transformInDouble(data, parallel, version, false);
+        return;
+    }
+
+    if (parallel) {
+        if (version == 4) {
+            DFT_parallel_sixstep(data);
+        } else {
+            DFT_parallel_V2(data);
+        }
+        return;
+    }
+    switch (version) {
+        case 1:
+            DFT_V1(data, N);
+            break;
+        case 2:
+            DFT_V2(data, N);
+            break;
+        case 3:
+            DFT_V3(data, N);
+            break;
+        case 6:
+            DFT_radix(data, N, FFTAlgorithm::Radix4);
+            break;
+        case 7:
+            DFT_radix(data, N, FFTAlgorithm::Radix8);
+            break;
+        case 8:
+            DFT_radix(data, N, FFTAlgorithm::SplitRadix);
+            break;
+    }
+}
+
+
+/**
+ * @brief Runs the inverse DFT of the given mode and version in place, in single precision.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm to use (see hasFloatEngine).
+ */
+void inverseDFT(std::vector<std::complex<float>>& data, bool parallel, int version) {
+    if (!hasFloatEngine(parallel, version)) {
+        transformInDouble(data, parallel, version, true);
+        return;
+    }
+
+    if (parallel) {
+        if (version == 4) {
+            invDFT_parallel_sixstep(data);
+        } else {
+            invDFT_parallel_V2(data);
+        }
+        return;
+    }
+    switch (version) {
+        case 1:
+            invDFT_V1(data);
+            break;
+        case 2:
+            invDFT_V2(data);
+            break;
+        case 3:
+            invDFT_V3(data);
+            break;
+        case 6:
+            invDFT_radix(data, FFTAlgorithm::Radix4);
+            break;
+        case 7:
+            invDFT_radix(data, FFTAlgorithm::Radix8);
+            break;
+        case 8:
+            invDFT_radix(data, FFTAlgorithm::SplitRadix);
+            break;
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef DFT_VERSIONS_H
+#define DFT_VERSIONS_H
+
+#include <complex>
+#include <string>
+#include <vector>
+
+// "auto" on the command line: the fastest plan measured by the auto-tuner (see autotune.h)
+const int AUTO_VERSION = -1;
+// "ntt" on the command line (multiplication only): exact product with the number-theoretic transform (see ntt.h)
+const int NTT_VERSION = -2;
+
+bool isPowerOfTwo(int N);
+bool isValidVersion(bool parallel, int version);
+std::string versionList(bool parallel);
+std::string versionName(int version);
+std::string versionLabel(bool parallel, int version);
+int resolveVersion(int N, bool parallel, int version);
+void forwardDFT(std::vector<std::complex<double>>& data, bool parallel, int version);
+void inverseDFT(std::vector<std::complex<double>>& data, bool parallel, int version);
+bool hasFloatEngine(bool parallel, int version);
+void forwardDFT(std::vector<std::complex<float>>& data, bool parallel, int version);
+void inverseDFT(std::vector<std::complex<float>>& data, bool parallel, int version);
+
+#endif
@@ -2,20 +2,18 @@
 #include <complex>
 #include <chrono>
 #include <iostream>
+#include <string>
 #include <vector>
 
-#include "parallel_dft/parallel_DFT_V0.h"
-#include "parallel_dft/parallel_DFT_V1.h"
-#include "parallel_dft/parallel_DFT_V2.h"
-#include "sequential_dft/sequential_DFT_V1.h"
-#include "sequential_dft/sequential_DFT_V2.h"
+#include "core/fft_plan.h"
+#include "core/thread_pool.h"
 
+#include "dft_versions.h"
 #include "full_dft.h"
 
 #define COLOR_RESET "\033[0m"
 #define COLOR_ORANGE "\033[38;5;214m"
 #define COLOR_GREEN "\033[32m"
-#define COLOR_BLUE "\033[34m"
 
 /**
  * @brief Computes the absolute error between two vectors of complex numbers.
@@ -34,108 +32,121 @@ double computeAbsoluteError(const std::vector<std::complex<double>>& vec1, const
 }
 
 
+/**
+ * @brief Widens a single-precision vector so that it can be compared with computeAbsoluteError.
+ */
+std::vector<std::complex<double>> toDoublePrecision(const std::vector<std::complex<float>>& data) {
+    return std::vector<std::complex<double>>(data.begin(), data.end());
+}
+
+
 /**
  * @brief Performs the full DFT computation on the input data, either in parallel or non-parallel mode.
  * 
+ * Any size is accepted: for sizes that are not a power of 2, the radix-2 versions are replaced
+ * by the mixed-radix version of the same mode (see resolveVersion).
+ * 
  * @param data Input vector of complex numbers.
  * @param parallel Boolean indicating whether to use parallel computation.
  * @param version Version of the DFT algorithm to use.
  */
 void full_dft(std::vector<std::complex<double>>& data,  bool parallel, int version){
-    
-    if (!parallel) {
-
-        if (version == 1) {
-            std::vector<std::complex<double>> original_data = data;
-            auto start1 = std::chrono::high_resolution_clock::now();
-            DFT_V1(data, data.size());
-            auto end1 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration1 = end1 - start1;
-            std::cout << COLOR_BLUE << "[Sequential V1]" << COLOR_RESET << "Time taken for the sequential DFT: " << COLOR_GREEN << duration1.count() << " seconds" << COLOR_RESET << std::endl;
-
-            auto start2 = std::chrono::high_resolution_clock::now();
-            invDFT_V1(data);
-            auto end2 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration2 = end2 - start2;
-            std::cout << COLOR_BLUE << "[Sequential V1]" << COLOR_RESET << "Time taken for the sequential inverse DFT: " << COLOR_GREEN << duration2.count() << " seconds" << COLOR_RESET << std::endl;
-
-            double error = computeAbsoluteError(original_data, data);
-            std::cout << COLOR_BLUE << "[Sequential V1]" << COLOR_RESET << "Error for the sequential DFT + inverse DFT transformation: " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
-        }
+    std::string kind = parallel ? "parallel" : "sequential";
 
-        if (version == 2) {
-            std::vector<std::complex<double>> original_data = data;
-            auto start1 = std::chrono::high_resolution_clock::now();
-            DFT_V2(data, data.size());
-            auto end1 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration1 = end1 - start1;
-            std::cout << COLOR_BLUE << "[Sequential V2]" << COLOR_RESET << "Time taken for the sequential DFT: " << COLOR_GREEN << duration1.count() << " seconds" << COLOR_RESET << std::endl;
-
-            auto start2 = std::chrono::high_resolution_clock::now();
-            invDFT_V2(data);
-            auto end2 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration2 = end2 - start2;
-            std::cout << COLOR_BLUE << "[Sequential V2]" << COLOR_RESET << "Time taken for the sequential inverse DFT: " << COLOR_GREEN << duration2.count() << " seconds" << COLOR_RESET << std::endl;
-
-            double error = computeAbsoluteError(original_data, data);
-            std::cout << COLOR_BLUE << "[Sequential V2]" << COLOR_RESET << "Error for the sequential DFT + inverse DFT transformation: " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
-        }
+    int resolved = resolveVersion(data.size(), parallel, version);
+    if (resolved != version) {
+        std::cout << versionLabel(parallel, version) << "N = " << data.size() << " is not a power of 2, using V" << resolved << " instead" << std::endl;
+        version = resolved;
+    }
+    std::string label = versionLabel(parallel, version);
+
+    ThreadPool& pool = getThreadPool();
+    pool.resetStats();
+
+    std::vector<std::complex<double>> original_data = data;
+    auto start1 = std::chrono::high_resolution_clock::now();
+    forwardDFT(data, parallel, version);
+    auto end1 = std::chrono::high_resolution_clock::now();
+    std::vector<std::complex<double>> spectrum = data;
+    std::chrono::duration<double> duration1 = end1 - start1;
+    std::cout << label << "Time taken for the " << kind << " DFT: " << COLOR_GREEN << duration1.count() << " seconds" << COLOR_RESET << std::endl;
+
+    auto start2 = std::chrono::high_resolution_clock::now();
+    inverseDFT(data, parallel, version);
+    auto end2 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration2 = end2 - start2;
+    std::cout << label << "Time taken for the " << kind << " inverse DFT: " << COLOR_GREEN << duration2.count() << " seconds" << COLOR_RESET << std::endl;
+
+    double error = computeAbsoluteError(original_data, data);
+    std::cout << label << "Error for the " << kind << " DFT + inverse DFT transformation: " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
+
+    if (parallel) {
+        // Two transforms were dispatched: the DFT and the inverse DFT
+        std::cout << label << "Thread pool dispatch overhead per transform: " << COLOR_GREEN << pool.dispatchOverhead() / 2 << " seconds" << COLOR_RESET << " (" << pool.dispatchCount() << " dispatches on " << pool.size() << " threads)" << std::endl;
+    }
 
-    } else {
-
-        if (version == 0) {
-            std::vector<std::complex<double>> original_data = data;
-            auto start1 = std::chrono::high_resolution_clock::now();
-            DFT_parallel_V0(data);
-            auto end1 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration1 = end1 - start1;
-            std::cout << COLOR_BLUE << "[Parallel V0] " << COLOR_RESET << "Time taken for the parallel DFT: " << COLOR_GREEN << duration1.count() << " seconds" << COLOR_RESET << std::endl;
-        
-            auto start2 = std::chrono::high_resolution_clock::now();
-            invDFT_parallel_V0(data);
-            auto end2 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration2 = end2 - start2;
-            std::cout << COLOR_BLUE << "[Parallel V0] " << COLOR_RESET << "Time taken for the parallel inverse DFT: " << COLOR_GREEN << duration2.count() << " seconds" << COLOR_RESET << std::endl;
-
-            double error = computeAbsoluteError(original_data, data);
-            std::cout << COLOR_BLUE << "[Parallel V0] " << COLOR_RESET << "Error for the parallel DFT + inverse DFT transformation: " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
-        }
+    // Same transforms in single precision, to choose the precision per workload
+    if (!hasFloatEngine(parallel, version)) {
+        std::cout << label << "No single-precision engine for this version, the float run below is computed in double" << std::endl;
+    }
+    std::vector<std::complex<float>> single_data(original_data.begin(), original_data.end());
+    auto start3 = std::chrono::high_resolution_clock::now();
+    forwardDFT(single_data, parallel, version);
+    auto end3 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration3 = end3 - start3;
+    double spectrum_difference = computeAbsoluteError(spectrum, toDoublePrecision(single_data));
+
+    inverseDFT(single_data, parallel, version);
+    double single_error = computeAbsoluteError(original_data, toDoublePrecision(single_data));
+
+    std::cout << label << "Time taken for the single-precision " << kind << " DFT: " << COLOR_GREEN << duration3.count() << " seconds" << COLOR_RESET << std::endl;
+    std::cout << label << "Error for the single-precision DFT + inverse DFT transformation: " << COLOR_ORANGE << single_error << COLOR_RESET << " (double: " << error << ")" << std::endl;
+    std::cout << label << "Difference between the single and double precision spectra: " << COLOR_ORANGE << spectrum_difference << COLOR_RESET << std::endl;
+}
 
-        if (version == 1) {
-            std::vector<std::complex<double>> original_data = data;
-            auto start1 = std::chrono::high_resolution_clock::now();
-            DFT_parallel_V1(data);
-            auto end1 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration1 = end1 - start1;
-            std::cout << COLOR_BLUE << "[Parallel V1] " << COLOR_RESET << "Time taken for the parallel DFT: " << COLOR_GREEN << duration1.count() << " seconds" << COLOR_RESET << std::endl;
-        
-            auto start2 = std::chrono::high_resolution_clock::now();
-            invDFT_parallel_V1(data);
-            auto end2 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration2 = end2 - start2;
-            std::cout << COLOR_BLUE << "[Parallel V1] " << COLOR_RESET << "Time taken for the parallel inverse DFT: " << COLOR_GREEN << duration2.count() << " seconds" << COLOR_RESET << std::endl;
-
-            double error = computeAbsoluteError(original_data, data);
-            std::cout << COLOR_BLUE << "[Parallel V1] " << COLOR_RESET << "Error for the parallel DFT + inverse DFT transformation: " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
-        }
 
-        if (version == 2) {
-            std::vector<std::complex<double>> original_data = data;
-            auto start1 = std::chrono::high_resolution_clock::now();
-            DFT_parallel_V2(data);
-            auto end1 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration1 = end1 - start1;
-            std::cout << COLOR_BLUE << "[Parallel V2] " << COLOR_RESET << "Time taken for the parallel DFT: " << COLOR_GREEN << duration1.count() << " seconds" << COLOR_RESET << std::endl;
-
-            auto start2 = std::chrono::high_resolution_clock::now();
-            invDFT_parallel_V2(data);
-            auto end2 = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double> duration2 = end2 - start2;
-            std::cout << COLOR_BLUE << "[Parallel V2] " << COLOR_RESET << "Time taken for the parallel inverse DFT: " << COLOR_GREEN << duration2.count() << " seconds" << COLOR_RESET << std::endl;
-
-            double error = computeAbsoluteError(original_data, data);
-            std::cout << COLOR_BLUE << "[Parallel V2] " << COLOR_RESET << "Error for the parallel DFT + inverse DFT transformation: " << COLOR_ORANGE << error << COLOR_RESET << std::endl;
+/**
+ * @brief Times the radix-2, radix-4, radix-8 and split-radix engines on the same data.
+ *
+ * Each engine runs the forward transform several times from a copy of the input and the median
+ * time is reported, with the speedup over radix-2 and the error against the radix-2 spectrum.
+ * Sizes that are not a power of 2 are not supported by these engines and are skipped.
+ *
+ * @param data Input vector of complex numbers (left unchanged).
+ */
+void compareRadix(const std::vector<std::complex<double>>& data) {
+    int N = data.size();
+    if (!isPowerOfTwo(N)) {
+        std::cerr << "The radix comparison needs a power-of-2 size, got N = " << N << std::endl;
+        return;
+    }
+
+    const int repetitions = 21;
+    const FFTAlgorithm algorithms[] = {FFTAlgorithm::Radix2, FFTAlgorithm::Radix4, FFTAlgorithm::Radix8, FFTAlgorithm::SplitRadix};
+
+    std::vector<std::complex<double>> reference = data;
+    executePlan(getPlan(N, false, 1, FFTAlgorithm::Radix2), reference);
+
+    double radix2_time = 0.0;
+    for (FFTAlgorithm algorithm : algorithms) {
+        const FFTPlan& plan = getPlan(N, false, 1, algorithm);
+        std::vector<double> times;
+        std::vector<std::complex<double>> buffer;
+        for (int r = 0; r < repetitions; r++) {
+            buffer = data;
+            auto start = std::chrono::high_resolution_clock::now();
+            executePlan(plan, buffer);
+            auto end = std::chrono::high_resolution_clock::now();
+            times.push_back(std::chrono::duration<double>(end - start).count());
         }
-    
+        std::nth_element(times.begin(), times.begin() + repetitions / 2, times.end());
+        double median = times[repetitions / 2];
+        if (algorithm == FFTAlgorithm::Radix2) {
+            radix2_time = median;
+        }
+
+        std::cout << "[" << algorithmName(algorithm) << "] " << "Median time: " << COLOR_GREEN << median << " seconds" << COLOR_RESET
+                  << ", speedup over radix-2: " << COLOR_GREEN << radix2_time / median << COLOR_RESET
+                  << ", error against radix-2: " << COLOR_ORANGE << computeAbsoluteError(reference, buffer) << COLOR_RESET << std::endl;
     }
 }
@@ -5,6 +5,8 @@
 #include <vector>
 
 double computeAbsoluteError(const std::vector<std::complex<double>>& vec1, const std::vector<std::complex<double>>& vec2);
+std::vector<std::complex<double>> toDoublePrecision(const std::vector<std::complex<float>>& data);
 void full_dft(std::vector<std::complex<double>>& data, bool parallel, int version);
+void compareRadix(const std::vector<std::complex<double>>& data);
 
 #endif
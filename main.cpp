@@ -1,9 +1,19 @@
 #include "compression.h"
 #include "multiplication.h"
+#include "bigint.h"
 #include "full_dft.h"
+#include "batch_dft.h"
+#include "stft.h"
+#include "convolution.h"
+#include "sliding_dft.h"
+#include "outofcore_dft.h"
+#include "dft_versions.h"
+#include "autotune.h"
 #include "plot.h"
 #include "data/import_data.h"
 #include "data/select_dataset.h"
+#include "core/thread_pool.h"
+#include "core/profiler.h"
 
 #include <iostream>
 #include <string>
@@ -11,11 +21,125 @@
 #include <complex>
 #include <filesystem>
 #include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
 namespace fs = std::filesystem;
 
-int p = 4;
+int p = 4; // number of processors, set at startup by chooseThreadCount
 
-void runComputation(const std::string& computation, int version, bool parallel, const std::string& mode) {
+
+/**
+ * @brief Picks the number of threads and removes the thread flag from the arguments.
+ *
+ * Priority: "--threads <n>" (or "-t <n>") on the command line, then the FFT_NUM_THREADS
+ * environment variable, then std::thread::hardware_concurrency().
+ *
+ * @param argc Argument count, decremented when the flag is removed.
+ * @param argv Argument vector, compacted when the flag is removed.
+ * @return The number of threads to use (at least 1).
+ */
+int chooseThreadCount(int& argc, char* argv[]) {
+    int num_threads = std::thread::hardware_concurrency();
+
+    const char* env = std::getenv("FFT_NUM_THREADS");
+    if (env != nullptr && std::atoi(env) > 0) {
+        num_threads = std::atoi(env);
+    }
+
+    for (int i = 1; i < argc - 1; i++) {
+        if (std::strcmp(argv[i], "--threads") == 0 || std::strcmp(argv[i], "-t") == 0) {
+            num_threads = std::stoi(argv[i + 1]);
+            for (int j = i; j + 2 <= argc; j++) {
+                argv[j] = argv[j + 2];
+            }
+            argc -= 2;
+            break;
+        }
+    }
+
+    return num_threads > 0 ? num_threads : 1;
+}
+
+/**
+ * @brief Reads the profiling flags and removes them from the arguments.
+ *
+ * "--profile <trace.json>" records the stage timers of the computation (builds made with
+ * make PROFILE=1) and writes them as a Chrome trace; "--counters" also reads the hardware
+ * counters of each stage.
+ *
+ * @param argc Argument count, decremented when a flag is removed.
+ * @param argv Argument vector, compacted when a flag is removed.
+ * @param counters Set to true if "--counters" is given.
+ * @return The trace file name, empty if profiling is not requested.
+ */
+std::string chooseProfile(int& argc, char* argv[], bool& counters) {
+    std::string trace_file;
+    counters = false;
+
+    for (int i = 1; i < argc; i++) {
+        int consumed = 0;
+        if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            trace_file = argv[i + 1];
+            consumed = 2;
+        } else if (std::strcmp(argv[i], "--counters") == 0) {
+            counters = true;
+            consumed = 1;
+        }
+        if (consumed > 0) {
+            for (int j = i; j + consumed <= argc; j++) {
+                argv[j] = argv[j + consumed];
+            }
+            argc -= consumed;
+            i--;
+        }
+    }
+
+    return trace_file;
+}
+
+/**
+ * @brief Reads the optional STFT arguments: [fft_length] [hop] [window].
+ *
+ * @return False if one of them is invalid.
+ */
+bool parseSTFTOptions(const std::vector<std::string>& options, STFTConfig& config) {
+    if (options.size() > 3) {
+        return false;
+    }
+    if (options.size() >= 1) {
+        config.fft_length = std::stoi(options[0]);
+    }
+    if (options.size() >= 2) {
+        config.hop = std::stoi(options[1]);
+    }
+    if (options.size() >= 3 && !parseWindow(options[2], config.window)) {
+        return false;
+    }
+    return config.fft_length >= 2 && config.hop >= 1;
+}
+
+/**
+ * @brief Sizes tuned by "./compute tune <mode>" without explicit sizes: the powers of 2 from
+ * 2^3 to 2^20 and the length of the selected dataset.
+ */
+std::vector<int> defaultTuneSizes() {
+    std::vector<int> sizes;
+    for (int log2N = 3; log2N <= 20; log2N++) {
+        sizes.push_back(1 << log2N);
+    }
+
+    loadSelectedDataset();
+    if (!data_file.empty()) {
+        int length = readWeatherData(data_file).size();
+        if (length > 0 && !isPowerOfTwo(length)) {
+            sizes.push_back(length);
+        }
+    }
+    return sizes;
+}
+
+void runComputation(const std::string& computation, int version, bool parallel, const std::string& mode, const std::vector<std::string>& options) {
     loadSelectedDataset();
 
     if (data_file.empty()) {
@@ -27,11 +151,12 @@ void runComputation(const std::string& computation, int version, bool parallel,
     std::vector<std::complex<double>> original_data;
 
     if (computation == "compression") {
-        data = readWeatherData(data_file);
-        original_data = data;
+        // Temperatures are real: use the real-input (R2C / C2R) transforms
+        std::vector<double> real_data = readWeatherDataReal(data_file);
+        std::vector<double> original_real_data = real_data;
         int k = 1500; // Example value for k
-        approximation(data, k, parallel, version);
-        plot_DFT(original_data, data, mode, computation, version);
+        approximation(real_data, k, parallel, version);
+        plot_DFT(original_real_data, real_data, mode, computation, version);
 
     } else if (computation == "full_dft") {
         data = readWeatherData(data_file);
@@ -39,14 +164,69 @@ void runComputation(const std::string& computation, int version, bool parallel,
         full_dft(data, parallel, version);
         plot_DFT(original_data, data, mode, computation, version);
 
+    } else if (computation == "stft") {
+        STFTConfig config;
+        if (!parseSTFTOptions(options, config)) {
+            std::cerr << "Usage: ./compute <sequential|parallel> stft <version> [fft_length] [hop] [rectangular|hann|hamming|blackman]" << std::endl;
+            return;
+        }
+        stft(readWeatherDataReal(data_file), config, parallel, version, mode);
+
+    } else if (computation == "filter") {
+        // Optional arguments: number of taps, add|save and the FFT length of the blocks (0 = automatic)
+        int taps = options.size() >= 1 ? std::stoi(options[0]) : 64;
+        ConvolutionMethod method = ConvolutionMethod::OverlapSave;
+        int fft_length = options.size() >= 3 ? std::stoi(options[2]) : 0;
+        if (options.size() > 3 || (options.size() >= 2 && !parseConvolutionMethod(options[1], method))) {
+            std::cerr << "Usage: ./compute <sequential|parallel> filter <version> [taps] [add|save] [fft_length]" << std::endl;
+            return;
+        }
+        filter_signal(readWeatherDataReal(data_file), taps, method, fft_length, parallel, version, mode);
+
+    } else if (computation == "sliding") {
+        // Optional argument: number of samples between two full transforms
+        int reanchor_interval = options.empty() ? 256 : std::stoi(options[0]);
+        data = readWeatherData(data_file);
+        sliding_dft(data, parallel, version, reanchor_interval);
+
+    } else if (computation == "outofcore") {
+        // Optional argument: memory budget of the blocks in KiB (small by default so that the
+        // datasets, which fit in memory, still go through several blocks)
+        size_t memory_budget = (options.empty() ? 64 : std::stoul(options[0])) * 1024;
+        data = readWeatherData(data_file);
+        outofcore_dft(data, parallel, version, memory_budget, mode);
+
+    } else if (computation == "batch") {
+        // Every dataset with as many days as the selected one is transformed in one batch
+        data = readWeatherData(data_file);
+        std::vector<std::vector<std::complex<double>>> series;
+        for (const auto& entry : fs::directory_iterator("data")) {
+            if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+                std::vector<std::complex<double>> signal = readWeatherData(entry.path().string());
+                if (signal.size() == data.size()) {
+                    series.push_back(signal);
+                }
+            }
+        }
+        batch_dft(series, parallel, version);
+
+    } else if (computation == "radix") {
+        data = readWeatherData(data_file);
+        compareRadix(data);
+
     } else if (computation == "multiplication") {
         std::vector<std::complex<double>> P = generateRandomPolynomial(2*2); 
         std::vector<std::complex<double>> Q = generateRandomPolynomial(2*2);
         std::vector<std::complex<double>> result1;
         std::vector<std::complex<double>> result2;
     
-        result1= multiply(P, Q, version);
+        result1= multiply(P, Q, parallel, version);
         result2 = multiply_naive(P, Q); 
+
+    } else if (computation == "bigint") {
+        // Optional argument: number of decimal digits of each factor
+        size_t digits = options.empty() ? 1000000 : std::stoull(options[0]);
+        bigint_multiplication(digits, parallel, version);
       
     } else {
         std::cerr << "Invalid computation: " << computation << std::endl;
@@ -55,8 +235,14 @@ void runComputation(const std::string& computation, int version, bool parallel,
 }
 
 int main(int argc, char* argv[]) {
+    p = chooseThreadCount(argc, argv);
+    bool counters;
+    std::string trace_file = chooseProfile(argc, argv, counters);
+    std::string wisdom_file = defaultWisdomPath();
+    bool wisdom_loaded = loadWisdom(wisdom_file);
+
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <command> [<args>]" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [--threads <n>] [--profile <trace.json> [--counters]] <command> [<args>]" << std::endl;
         return 1;
     }
 
@@ -72,29 +258,51 @@ int main(int argc, char* argv[]) {
             std::cerr << "Usage: " << argv[0] << " dataset [<num>]" << std::endl;
         }
 
+    } else if (command == "tune") {
+        std::string mode = argc >= 3 ? argv[2] : "";
+        if (mode != "sequential" && mode != "parallel") {
+            std::cerr << "Usage: " << argv[0] << " tune <sequential|parallel> [<N> ...]" << std::endl;
+            return 1;
+        }
+
+        std::vector<int> sizes;
+        for (int i = 3; i < argc; i++) {
+            sizes.push_back(std::stoi(argv[i]));
+        }
+        if (sizes.empty()) {
+            sizes = defaultTuneSizes();
+        }
+
+        initThreadPool(p);
+        autotune(sizes, mode == "parallel", wisdom_file);
+
     } else {
 
-        if (argc != 4) {
+        // Only the stft, filter, sliding, outofcore and bigint computations take extra arguments
+        std::string extra_args_computations = " stft filter sliding outofcore bigint ";
+        if (argc < 4 || (argc > 4 && extra_args_computations.find(" " + std::string(argv[2]) + " ") == std::string::npos)) {
             std::cerr << "Usage: " << argv[0] << " <sequential|parallel> <computation> <version>" << std::endl;
             return 1;
         }
 
         std::string mode = argv[1];
         std::string computation = argv[2];
-        int version = std::stoi(argv[3]);
+        std::string version_arg = argv[3];
+        int version = version_arg == "auto" ? AUTO_VERSION : version_arg == "ntt" ? NTT_VERSION : std::stoi(version_arg);
+        std::vector<std::string> options(argv + 4, argv + argc);
         bool parallel;
 
         if (mode == "sequential") {
             parallel = false;
-            if (version != 1 && version != 2) {
-                std::cerr << "Invalid version for sequential computation: version " << version << " does not exist, select from {1, 2}." << std::endl;
+            if (!isValidVersion(parallel, version) && !(version == NTT_VERSION && computation == "multiplication")) {
+                std::cerr << "Invalid version for sequential computation: version " << versionName(version) << " does not exist, select from " << versionList(parallel) << "." << std::endl;
                 return 1;
             }
 
         } else if (mode == "parallel") {
             parallel = true;
-            if (version != 0 && version != 1 && version != 2) {
-                std::cerr << "Invalid version for parallel computation: version " << version << " does not exist, select from {0, 1, 2}." << std::endl;
+            if (!isValidVersion(parallel, version) && !(version == NTT_VERSION && computation == "multiplication")) {
+                std::cerr << "Invalid version for parallel computation: version " << versionName(version) << " does not exist, select from " << versionList(parallel) << "." << std::endl;
                 return 1;
             }
 
@@ -104,7 +312,29 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        runComputation(computation, version, parallel, mode);
+        // Worker threads are created once here and shared by every parallel version
+        initThreadPool(p);
+
+        if (version == AUTO_VERSION && !wisdom_loaded) {
+            std::cout << "No wisdom file (" << wisdom_file << "): the auto version uses default plans, run './compute tune " << mode << "' to measure them." << std::endl;
+        }
+
+        if (!trace_file.empty() && !profilerStart(counters)) {
+            profilerReport(std::cout);
+            trace_file.clear();
+        }
+
+        runComputation(computation, version, parallel, mode, options);
+
+        if (!trace_file.empty()) {
+            profilerStop();
+            profilerReport(std::cout);
+            if (profilerWriteTrace(trace_file)) {
+                std::cout << "Stage trace written to " << trace_file << std::endl;
+            } else {
+                std::cerr << "Could not write the stage trace to " << trace_file << std::endl;
+            }
+        }
         return 0;
     }
 }
@@ -8,14 +8,14 @@
 #include <chrono>
 #include <algorithm>
 #include <random>
+#include <cstdint>
+#include <utility>
 
-#include "parallel_dft/parallel_DFT_V0.h"
-#include "parallel_dft/parallel_DFT_V1.h"
-#include "parallel_dft/parallel_DFT_V2.h"
-#include "sequential_dft/sequential_DFT_V1.h"
-#include "sequential_dft/sequential_DFT_V2.h"
-
+#include "core/fft_plan.h"
+#include "core/thread_pool.h"
+#include "dft_versions.h"
 #include "multiplication.h"
+#include "ntt.h"
 
 #define COLOR_RESET "\033[0m"
 #define COLOR_GREEN "\033[32m"
@@ -23,6 +23,35 @@
 #define COLOR_BLUE "\033[34m"
 
 
+/**
+ * @brief Multiplies two polynomials with integer coefficients exactly, with the NTT (version "ntt").
+ *
+ * The real parts of the coefficients are rounded to integers; the product has no rounding error.
+ */
+static std::vector<std::complex<double>> multiplyNTT(const std::vector<std::complex<double>>& P, const std::vector<std::complex<double>>& Q, bool parallel) {
+    auto start_time = std::chrono::steady_clock::now();
+
+    auto toIntegers = [](const std::vector<std::complex<double>>& polynomial) {
+        std::vector<int64_t> coefficients(polynomial.size());
+        for (size_t i = 0; i < polynomial.size(); i++) {
+            coefficients[i] = std::llround(polynomial[i].real());
+        }
+        return coefficients;
+    };
+    std::vector<int64_t> product = convolveExact(toIntegers(P), toIntegers(Q), parallel);
+
+    std::vector<std::complex<double>> PQ(product.begin(), product.end());
+
+    auto end_time = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed_time = end_time - start_time;
+
+    std::cout << "Lenght of resulting polynom PQ: " << PQ.size() << std::endl;
+    std::cout << versionLabel(parallel, NTT_VERSION) << "Time taken for the multiplication: " << COLOR_GREEN << elapsed_time.count() << " seconds" << COLOR_RESET << std::endl;
+
+    return PQ;
+}
+
+
 // Input: Polynomials P, Q as a list of their coefficients
 // Ouput: P*Q as a list of its coeff
 
@@ -31,9 +60,15 @@
  * 
  * @param P First polynomial represented as a vector of complex numbers.
  * @param Q Second polynomial represented as a vector of complex numbers.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm to use, or NTT_VERSION for the exact integer product.
  * @return Resultant polynomial coefficients after multiplication.
  */
-std::vector<std::complex<double>> multiply(std::vector<std::complex<double>> P,  std::vector<std::complex<double>> Q, int version) {
+std::vector<std::complex<double>> multiply(const std::vector<std::complex<double>>& P, const std::vector<std::complex<double>>& Q, bool parallel, int version) {
+    if (version == NTT_VERSION) {
+        return multiplyNTT(P, Q, parallel);
+    }
+
     /*std::cout << "Starting polynomials: " << std::endl;
     std::cout << "  * " << COLOR_PURPLE << "P = {";
     for (const auto& coeff : P) {std::cout << coeff << ", ";}
@@ -46,55 +81,71 @@ std::vector<std::complex<double>> multiply(std::vector<std::complex<double>> P,
 
     int len_P = P.size();
     int len_Q = Q.size();
-    int len_PQ= 2*(len_P + len_Q);
-
+    int len_result = len_P + len_Q - 1;
 
-    // Ensure len_PQ is a power of 2
-    while (std::fmod(std::log2(len_PQ), 1) != 0) {
-        len_PQ += 1;
+    // Smallest power of 2 that holds the whole product, so that the cyclic convolution is linear
+    int len_PQ = 4;
+    while (len_PQ < len_result) {
+        len_PQ <<= 1;
     }
+    int half = len_PQ / 2;
 
-    // Pad the two lists with 0s
-    if (P.size() < len_PQ) {
-        P.resize(len_PQ, 0);}
-    if (Q.size() < len_PQ) {
-        Q.resize(len_PQ, 0); }
-
-    std::vector<std::complex<double>> DFT_P = P;
-    std::vector<std::complex<double>> DFT_Q = Q ;
-
-    switch (version) {
-        case 0:
-            DFT_parallel_V0(DFT_P);
-            DFT_parallel_V0(DFT_Q);
-            break;
-        case 1:
-            DFT_parallel_V1(DFT_P);
-            DFT_parallel_V1(DFT_Q);
-            break;
-        case 2:
-            DFT_parallel_V2(DFT_P);
-            DFT_parallel_V2(DFT_Q);
-            break;
+    // Both real polynomials in one complex transform: Z = DFT(P + iQ)
+    std::vector<std::complex<double>> Z(len_PQ, 0.0);
+    for (int i = 0; i < len_P; i++) {
+        Z[i] = P[i].real();
     }
-    
-    std::vector<std::complex<double>> DFT_PQ(len_PQ); 
-    for (int i=0; i<len_PQ; i++ ){
-        DFT_PQ[i]= DFT_P[i] * DFT_Q[i];
+    for (int i = 0; i < len_Q; i++) {
+        Z[i] += std::complex<double>(0.0, Q[i].real());
+    }
+    forwardDFT(Z, parallel, resolveVersion(len_PQ, parallel, version));
+
+    // DFT_P[k] = (Z[k] + conj(Z[-k])) / 2 and DFT_Q[k] = (Z[k] - conj(Z[-k])) / 2i
+    auto productBin = [&](int k) {
+        std::complex<double> Zk = Z[k];
+        std::complex<double> Zc = std::conj(Z[(len_PQ - k) & (len_PQ - 1)]);
+        return (Zk + Zc) * 0.5 * ((Zk - Zc) * std::complex<double>(0.0, -0.5));
+    };
+
+    // The product is real: its inverse is a complex inverse DFT of size len_PQ / 2 (as in invRealDFT).
+    // Bins k and half - k only depend on Z[k], Z[half - k], Z[half + k] and Z[len_PQ - k], so the
+    // input of that inverse overwrites Z[k] and Z[half - k] in the same pass as the products.
+    const std::vector<std::complex<double>>& twiddle = getPackTwiddles<double>(len_PQ);
+    auto packBin = [&](int k, std::complex<double> Xk, std::complex<double> Xm) {
+        std::complex<double> Xc = std::conj(Xm);
+        std::complex<double> even = (Xk + Xc) * 0.5;
+        std::complex<double> odd = (Xk - Xc) * 0.5 * std::conj(twiddle[k]);
+        return even + std::complex<double>(0.0, 1.0) * odd;
+    };
+    auto fusedBins = [&](int first, int last) {
+        for (int k = first; k < last; k++) {
+            int m = half - k;
+            std::complex<double> Wk = productBin(k);
+            std::complex<double> Wm = productBin(m);
+            Z[k] = packBin(k, Wk, Wm);
+            if (k > 0 && m != k) {
+                Z[m] = packBin(m, Wm, Wk);
+            }
+        }
+    };
+    if (parallel) {
+        getThreadPool().parallel_for(0, half / 2 + 1, fusedBins);
+    } else {
+        fusedBins(0, half / 2 + 1);
     }
 
-    switch (version) {
-        case 0:
-            invDFT_parallel_V0(DFT_PQ);
-            break;
-        case 1:
-            invDFT_parallel_V1(DFT_PQ);
-            break;
-        case 2:
-            invDFT_parallel_V2(DFT_PQ);
-            break;
+    Z.resize(half);
+    inverseDFT(Z, parallel, resolveVersion(half, parallel, version));
+
+    // Even coefficients in the real parts, odd ones in the imaginary parts: unpack from the end
+    Z.resize(len_PQ);
+    for (int n = half - 1; n >= 0; n--) {
+        std::complex<double> pair = Z[n];
+        Z[2 * n + 1] = pair.imag();
+        Z[2 * n] = pair.real();
     }
-    DFT_PQ.resize(len_P + len_Q - 1);
+    Z.resize(len_result);
+    std::vector<std::complex<double>> DFT_PQ = std::move(Z);
 
 
     std::cout << "Lenght of resulting polynom PQ: " << len_PQ << std::endl;
@@ -102,19 +153,13 @@ std::vector<std::complex<double>> multiply(std::vector<std::complex<double>> P,
     auto end_time = std::chrono::steady_clock::now();
     std::chrono::duration<double> elapsed_time = end_time - start_time;
 
-    // We don't consider this in the total time because in a final version with the computations inside a ring of integers
-    // This woud not be considered
-    for (int i=0; i< len_P + len_Q-1 ; i++ ){
-        DFT_PQ[i]= DFT_PQ[i].real();
-    }
-
     /*std::cout << COLOR_BLUE << "[Parallel V" << version << "] " << COLOR_RESET << "Resulting polynomial coefficients after multiplication:" << std::endl << " * " << COLOR_PURPLE << "PQ = {";
     for (const auto& coeff : DFT_PQ) {
         std::cout << coeff << ", ";
     }
     std::cout << "}" << COLOR_RESET << std::endl;
 */
-    std::cout << COLOR_BLUE << "[Parallel V" << version << "] " << COLOR_RESET << "Time taken for the multiplication: " << COLOR_GREEN << elapsed_time.count() << " seconds" << COLOR_RESET << std::endl;
+    std::cout << versionLabel(parallel, version) << "Time taken for the multiplication: " << COLOR_GREEN << elapsed_time.count() << " seconds" << COLOR_RESET << std::endl;
   
 
     return DFT_PQ;
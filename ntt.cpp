@@ -0,0 +1,388 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "parallel_dft/p_transpose.h"
+#include "ntt.h"
+
+extern int p; // number of processors
+
+// 998244353 = 119 * 2^23 + 1, 167772161 = 5 * 2^25 + 1, 469762049 = 7 * 2^26 + 1 (product about 2^86)
+const NTTPrime NTT_PRIMES[NTT_NUM_PRIMES] = {
+    {998244353, 3, 23},
+    {167772161, 3, 25},
+    {469762049, 3, 26},
+};
+
+
+/**
+ * @brief Montgomery arithmetic modulo an odd 32-bit modulus below 2^31.
+ *
+ * Values are kept in Montgomery form x * 2^32 mod modulus, so that a modular product is two
+ * 32x32-bit multiplications and a shift instead of a 64-bit division.
+ */
+struct Montgomery {
+    uint32_t modulus;
+    uint32_t negative_inverse; // -modulus^-1 mod 2^32
+    uint32_t r2;               // 2^64 mod modulus
+
+    explicit Montgomery(uint32_t modulus) : modulus(modulus) {
+        uint32_t inverse = modulus; // Newton iteration: each step doubles the number of correct bits
+        for (int i = 0; i < 4; i++) {
+            inverse *= 2 - modulus * inverse;
+        }
+        negative_inverse = -inverse;
+        r2 = (uint32_t) ((((unsigned __int128) 1) << 64) % modulus);
+    }
+
+    uint32_t reduce(uint64_t x) const {
+        uint32_t m = (uint32_t) x * negative_inverse;
+        uint32_t t = (x + (uint64_t) m * modulus) >> 32;
+        return t >= modulus ? t - modulus : t;
+    }
+
+    uint32_t multiply(uint32_t a, uint32_t b) const {
+        return reduce((uint64_t) a * b);
+    }
+
+    uint32_t add(uint32_t a, uint32_t b) const {
+        uint32_t sum = a + b;
+        return sum >= modulus ? sum - modulus : sum;
+    }
+
+    uint32_t subtract(uint32_t a, uint32_t b) const {
+        return a >= b ? a - b : a + modulus - b;
+    }
+
+    uint32_t toMontgomery(uint32_t x) const {
+        return multiply(x, r2);
+    }
+
+    uint32_t fromMontgomery(uint32_t x) const {
+        return reduce(x);
+    }
+
+    uint32_t power(uint32_t base, uint64_t exponent) const {
+        uint32_t result = toMontgomery(1);
+        for (base = toMontgomery(base); exponent > 0; exponent >>= 1) {
+            if (exponent & 1) {
+                result = multiply(result, base);
+            }
+            base = multiply(base, base);
+        }
+        return fromMontgomery(result);
+    }
+};
+
+
+/**
+ * @brief Tables of an NTT of size N modulo one prime, in Montgomery form.
+ *
+ * roots[k] = w^k for k < N/2, with w a primitive N-th root of unity (its inverse for an inverse plan).
+ * scale is 1/N for an inverse plan, 1 otherwise.
+ */
+struct NTTPlan {
+    int N;
+    Montgomery arithmetic;
+    std::vector<uint32_t> roots;
+    uint32_t scale;
+};
+
+static std::map<std::tuple<int, int, bool>, std::unique_ptr<NTTPlan>> ntt_cache;
+static std::mutex ntt_cache_mutex;
+
+
+static const NTTPlan& getNTTPlan(int N, int prime, bool inverse) {
+    std::lock_guard<std::mutex> lock(ntt_cache_mutex);
+
+    auto key = std::make_tuple(N, prime, inverse);
+    auto it = ntt_cache.find(key);
+    if (it != ntt_cache.end()) {
+        return *it->second;
+    }
+
+    const NTTPrime& modulus = NTT_PRIMES[prime];
+    auto plan = std::make_unique<NTTPlan>(NTTPlan{N, Montgomery(modulus.modulus), {}, 0});
+    const Montgomery& arithmetic = plan->arithmetic;
+
+    uint32_t root = arithmetic.power(modulus.primitive_root, (modulus.modulus - 1) / N);
+    if (inverse) {
+        root = arithmetic.power(root, modulus.modulus - 2);
+    }
+    uint32_t root_montgomery = arithmetic.toMontgomery(root);
+
+    plan->roots.resize(std::max(N / 2, 1));
+    plan->roots[0] = arithmetic.toMontgomery(1);
+    for (int k = 1; k < N / 2; k++) {
+        plan->roots[k] = arithmetic.multiply(plan->roots[k - 1], root_montgomery);
+    }
+    plan->scale = arithmetic.toMontgomery(inverse ? arithmetic.power(N, modulus.modulus - 2) : 1);
+
+    return *ntt_cache.emplace(key, std::move(plan)).first->second;
+}
+
+
+/**
+ * @brief Runs body(first, last) over [0, n), on the thread pool in parallel mode.
+ */
+static void forRange(bool parallel, int n, const std::function<void(int, int)>& body) {
+    if (parallel) {
+        getThreadPool().parallel_for(0, n, body);
+    } else if (n > 0) {
+        body(0, n);
+    }
+}
+
+
+/**
+ * @brief In-place iterative radix-2 NTT of one block of size n (n divides plan.N).
+ *
+ * The stage of length len uses the roots w_N^(j * N/len) = w_len^j.
+ */
+static void leafNTT(uint32_t* block, int n, const NTTPlan& plan) {
+    const Montgomery& arithmetic = plan.arithmetic;
+
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(block[i], block[j]);
+        }
+    }
+
+    for (int len = 2; len <= n; len <<= 1) {
+        int half = len / 2;
+        int stride = plan.N / len;
+        for (int i = 0; i < n; i += len) {
+            for (int j = 0; j < half; j++) {
+                uint32_t u = block[i + j];
+                uint32_t v = arithmetic.multiply(block[i + j + half], plan.roots[j * stride]);
+                block[i + j] = arithmetic.add(u, v);
+                block[i + j + half] = arithmetic.subtract(u, v);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief NTT of Montgomery-form values in place, with the block structure of parallel V2.
+ *
+ * In parallel mode the input is scattered into chooseBlockCount(p, N) blocks (scatter_blocks),
+ * each block gets its own NTT on the thread pool, and the remaining radix-2 stages combine
+ * them, each stage shared out over the pool and separated by a barrier.
+ */
+static void transformMontgomery(std::vector<uint32_t>& data, const NTTPlan& plan, bool parallel) {
+    int N = data.size();
+    const Montgomery& arithmetic = plan.arithmetic;
+    int num_blocks = parallel ? chooseBlockCount(p, N) : 1;
+    int block_size = N / num_blocks;
+
+    if (num_blocks > 1) {
+        std::vector<uint32_t> scattered(N);
+        scatter_blocks(data.data(), scattered.data(), chooseSequence(num_blocks), N);
+        data.swap(scattered);
+
+        ThreadPool& pool = getThreadPool();
+        pool.run(num_blocks, [&](int b) {
+            leafNTT(data.data() + (size_t) b * block_size, block_size, plan);
+        });
+
+        int team = std::min(pool.teamSize(), N / 2);
+        Barrier barrier(team);
+        pool.run(team, [&](int t) {
+            int first = (long long) (N / 2) * t / team;
+            int last = (long long) (N / 2) * (t + 1) / team;
+
+            for (int len = 2 * block_size; len <= N; len <<= 1) {
+                int half = len / 2;
+                int stride = N / len;
+                for (int b = first; b < last; b++) {
+                    int j = b & (half - 1);
+                    int i = 2 * (b - j) + j;
+                    uint32_t u = data[i];
+                    uint32_t v = arithmetic.multiply(data[i + half], plan.roots[j * stride]);
+                    data[i] = arithmetic.add(u, v);
+                    data[i + half] = arithmetic.subtract(u, v);
+                }
+                barrier.wait();
+            }
+        });
+    } else {
+        leafNTT(data.data(), N, plan);
+    }
+
+    if (plan.scale != arithmetic.toMontgomery(1)) {
+        forRange(parallel, N, [&](int first, int last) {
+            for (int i = first; i < last; i++) {
+                data[i] = arithmetic.multiply(data[i], plan.scale);
+            }
+        });
+    }
+}
+
+
+/**
+ * @brief Number-theoretic transform in place: X[k] = sum_n x[n] w^(nk) mod NTT_PRIMES[prime].modulus.
+ *
+ * @param data Values in [0, modulus); size a power of 2 up to 2^NTT_PRIMES[prime].max_log2.
+ * @param prime Index of the prime in NTT_PRIMES.
+ * @param inverse True for the inverse transform (including the 1/N factor).
+ * @param parallel Boolean indicating whether to use parallel computation.
+ */
+void NTT(std::vector<uint32_t>& data, int prime, bool inverse, bool parallel) {
+    const NTTPlan& plan = getNTTPlan(data.size(), prime, inverse);
+    const Montgomery& arithmetic = plan.arithmetic;
+
+    forRange(parallel, data.size(), [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            data[i] = arithmetic.toMontgomery(data[i]);
+        }
+    });
+    transformMontgomery(data, plan, parallel);
+    forRange(parallel, data.size(), [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            data[i] = arithmetic.fromMontgomery(data[i]);
+        }
+    });
+}
+
+
+/**
+ * @brief Residues of the cyclic convolution of a and b (zero-padded to N) modulo one prime.
+ */
+static std::vector<uint32_t> convolveModulo(const std::vector<int64_t>& a, const std::vector<int64_t>& b, int N, int prime, bool parallel) {
+    const NTTPlan& forward = getNTTPlan(N, prime, false);
+    const NTTPlan& inverse = getNTTPlan(N, prime, true);
+    const Montgomery& arithmetic = forward.arithmetic;
+    int64_t modulus = arithmetic.modulus;
+
+    auto load = [&](const std::vector<int64_t>& x) {
+        std::vector<uint32_t> residues(N, 0);
+        forRange(parallel, x.size(), [&](int first, int last) {
+            for (int i = first; i < last; i++) {
+                residues[i] = arithmetic.toMontgomery((uint32_t) ((x[i] % modulus + modulus) % modulus));
+            }
+        });
+        return residues;
+    };
+    std::vector<uint32_t> A = load(a);
+    std::vector<uint32_t> B = load(b);
+
+    transformMontgomery(A, forward, parallel);
+    transformMontgomery(B, forward, parallel);
+    forRange(parallel, N, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            A[i] = arithmetic.multiply(A[i], B[i]);
+        }
+    });
+    transformMontgomery(A, inverse, parallel);
+
+    forRange(parallel, N, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            A[i] = arithmetic.fromMontgomery(A[i]);
+        }
+    });
+    return A;
+}
+
+
+/**
+ * @brief Exact linear convolution of two integer sequences (e.g. polynomial coefficients).
+ *
+ * The convolution is computed modulo as many primes of NTT_PRIMES as the coefficient bound
+ * max|a| * max|b| * min(len a, len b) requires, and the signed result is rebuilt from its
+ * residues with Garner's form of the Chinese remainder theorem.
+ *
+ * @return a * b, or an empty vector if a result could exceed 64 bits or the size exceeds 2^23.
+ */
+std::vector<int64_t> convolveExact(const std::vector<int64_t>& a, const std::vector<int64_t>& b, bool parallel) {
+    if (a.empty() || b.empty()) {
+        return {};
+    }
+
+    auto maxAbs = [](const std::vector<int64_t>& x) {
+        long double largest = 0;
+        for (int64_t v : x) {
+            largest = std::max(largest, std::fabs((long double) v));
+        }
+        return largest;
+    };
+    long double bound = maxAbs(a) * maxAbs(b) * std::min(a.size(), b.size());
+    if (bound >= 9.2e18L) {
+        std::cerr << "convolveExact: the coefficients of the product may not fit in 64 bits" << std::endl;
+        return {};
+    }
+
+    // Signed results in (-M/2, M/2) are recovered from their residues modulo M = product of the primes
+    int num_primes = 1;
+    long double modulus_product = NTT_PRIMES[0].modulus;
+    while (2 * bound >= modulus_product) {
+        modulus_product *= NTT_PRIMES[num_primes].modulus;
+        num_primes++;
+    }
+
+    int length = a.size() + b.size() - 1;
+    int N = 1;
+    while (N < length) {
+        N <<= 1;
+    }
+    if (N > (1 << NTT_PRIMES[0].max_log2)) {
+        std::cerr << "convolveExact: size " << N << " is larger than the 2^" << NTT_PRIMES[0].max_log2 << " supported by the primes" << std::endl;
+        return {};
+    }
+
+    std::vector<std::vector<uint32_t>> residues;
+    for (int prime = 0; prime < num_primes; prime++) {
+        residues.push_back(convolveModulo(a, b, N, prime, parallel));
+    }
+
+    const uint64_t p1 = NTT_PRIMES[0].modulus, p2 = NTT_PRIMES[1].modulus, p3 = NTT_PRIMES[2].modulus;
+    Montgomery m2(p2), m3(p3);
+    const uint64_t inverse_p1_mod_p2 = m2.power(p1 % p2, p2 - 2);
+    const uint64_t inverse_p1p2_mod_p3 = m3.power(p1 * p2 % p3, p3 - 2);
+    unsigned __int128 M = p1;
+    for (int prime = 1; prime < num_primes; prime++) {
+        M *= NTT_PRIMES[prime].modulus;
+    }
+
+    std::vector<int64_t> result(length);
+    forRange(parallel, length, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            // x = r1 + p1 * t2 + p1 * p2 * t3 with t2 < p2 and t3 < p3
+            uint64_t r1 = residues[0][i];
+            unsigned __int128 x = r1;
+            if (num_primes >= 2) {
+                uint64_t t2 = (residues[1][i] + p2 - r1 % p2) % p2 * inverse_p1_mod_p2 % p2;
+                x += (unsigned __int128) p1 * t2;
+                if (num_primes == 3) {
+                    uint64_t x_mod_p3 = (uint64_t) (x % p3);
+                    uint64_t t3 = (residues[2][i] + p3 - x_mod_p3) % p3 * inverse_p1p2_mod_p3 % p3;
+                    x += (unsigned __int128) p1 * p2 * t3;
+                }
+            }
+            result[i] = x > M / 2 ? -(int64_t) (M - x) : (int64_t) x;
+        }
+    });
+    return result;
+}
+
+
+/**
+ * @brief Frees every cached NTT plan.
+ */
+void clearNTTCache() {
+    std::lock_guard<std::mutex> lock(ntt_cache_mutex);
+    ntt_cache.clear();
+}
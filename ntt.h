@@ -0,0 +1,24 @@
+#ifndef NTT_H
+#define NTT_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Prime modulus = c * 2^max_log2 + 1 with a primitive root: it has roots of unity of
+ * every power-of-2 order up to 2^max_log2, so it supports NTTs of those sizes.
+ */
+struct NTTPrime {
+    uint32_t modulus;
+    uint32_t primitive_root;
+    int max_log2;
+};
+
+const int NTT_NUM_PRIMES = 3;
+extern const NTTPrime NTT_PRIMES[NTT_NUM_PRIMES];
+
+void NTT(std::vector<uint32_t>& data, int prime, bool inverse, bool parallel);
+std::vector<int64_t> convolveExact(const std::vector<int64_t>& a, const std::vector<int64_t>& b, bool parallel);
+void clearNTTCache();
+
+#endif
@@ -0,0 +1,353 @@
+#include <algorithm>
+#include <complex>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "core/fft_plan.h"
+#include "core/thread_pool.h"
+#include "parallel_dft/p_transpose.h"
+
+#include "dft_versions.h"
+#include "full_dft.h"
+#include "outofcore_dft.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_ORANGE "\033[38;5;214m"
+#define COLOR_GREEN "\033[32m"
+
+using complex = std::complex<double>;
+
+// The files hold raw complex<double> values: real and imaginary parts, native byte order
+const size_t COMPLEX_BYTES = sizeof(complex);
+
+
+/**
+ * @brief Reads exactly size bytes at offset, retrying on short reads.
+ */
+static bool preadAll(int fd, void* buffer, size_t size, off_t offset) {
+    char* out = static_cast<char*>(buffer);
+    while (size > 0) {
+        ssize_t n = pread(fd, out, size, offset);
+        if (n <= 0) {
+            return false;
+        }
+        out += n;
+        size -= n;
+        offset += n;
+    }
+    return true;
+}
+
+
+/**
+ * @brief Writes exactly size bytes at offset, retrying on short writes.
+ */
+static bool pwriteAll(int fd, const void* buffer, size_t size, off_t offset) {
+    const char* in = static_cast<const char*>(buffer);
+    while (size > 0) {
+        ssize_t n = pwrite(fd, in, size, offset);
+        if (n <= 0) {
+            return false;
+        }
+        in += n;
+        size -= n;
+        offset += n;
+    }
+    return true;
+}
+
+
+bool writeComplexFile(const std::string& filename, const std::vector<complex>& data) {
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = pwriteAll(fd, data.data(), data.size() * COMPLEX_BYTES, 0);
+    close(fd);
+    return ok;
+}
+
+
+bool readComplexFile(const std::string& filename, std::vector<complex>& data) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    data.resize(info.st_size / COMPLEX_BYTES);
+    bool ok = preadAll(fd, data.data(), data.size() * COMPLEX_BYTES, 0);
+    close(fd);
+    return ok;
+}
+
+
+/**
+ * @brief Runs count block jobs with asynchronous read-ahead and write-behind.
+ *
+ * The three buffers rotate: while block i is computed in buffer i % 3, block i + 1 is read into
+ * the next buffer and block i - 1 is written back from the previous one, so both the reads and
+ * the writes overlap the transforms. The only wait is for the write of block i - 2 before block
+ * i + 1 is read into its buffer.
+ *
+ * @return False if a read or a write failed.
+ */
+template <typename Read, typename Compute, typename Write>
+static bool pipeline(int count, std::vector<complex>* buffers, Read read, Compute compute, Write write) {
+    std::future<bool> pending_read = std::async(std::launch::async, read, 0, std::ref(buffers[0]));
+    std::future<bool> pending_writes[3];
+    bool ok = true;
+
+    auto finishWrite = [&](int slot) {
+        if (pending_writes[slot].valid()) {
+            ok = pending_writes[slot].get() && ok;
+        }
+    };
+
+    for (int i = 0; i < count; i++) {
+        bool read_ok = pending_read.get();
+        if (i + 1 < count) {
+            finishWrite((i + 1) % 3);
+            pending_read = std::async(std::launch::async, read, i + 1, std::ref(buffers[(i + 1) % 3]));
+        }
+        if (!read_ok) {
+            ok = false;
+            continue;
+        }
+
+        compute(i, buffers[i % 3]);
+        finishWrite(i % 3);
+        pending_writes[i % 3] = std::async(std::launch::async, write, i, std::ref(buffers[i % 3]));
+    }
+    for (int slot = 0; slot < 3; slot++) {
+        finishWrite(slot);
+    }
+    return ok;
+}
+
+
+/**
+ * @brief Computes the DFT of a file of complex numbers larger than memory, writing the spectrum to another file.
+ *
+ * The N = R * C values are viewed as an R x C row-major matrix (four-step algorithm):
+ *  1. blocks of columns are read (one run of B values per row), each column gets an FFT of
+ *     length R and the twiddle w_N^(c k1), and the block is written back to a scratch file
+ *     laid out as R rows of C values;
+ *  2. blocks of rows of the scratch file are read contiguously, each row gets an FFT of length
+ *     C, and the block is transposed so that X[k1 + R k2] is written at its natural position.
+ * Only four blocks of memory_budget / 4 bytes are in memory at a time: the three buffers of the
+ * pipeline and the transpose target of pass 2. The FFTs inside a block are shared out over the
+ * thread pool, and reads and writes run asynchronously.
+ *
+ * @param input_file File of N complex<double> values (N a power of 2).
+ * @param output_file File receiving the N values of the spectrum.
+ * @param scratch_dir Directory of the intermediate file (removed at the end).
+ * @param memory_budget Number of bytes the blocks may use; N must be at most (memory_budget / 64)².
+ * @param inverse True for the inverse DFT.
+ * @return False on an I/O error or an unsupported size.
+ */
+bool outOfCoreDFT(const std::string& input_file, const std::string& output_file, const std::string& scratch_dir, size_t memory_budget, bool inverse) {
+    int input = open(input_file.c_str(), O_RDONLY);
+    if (input < 0) {
+        std::cerr << "Cannot open " << input_file << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(input, &info) != 0) {
+        std::cerr << "Cannot read the size of " << input_file << std::endl;
+        close(input);
+        return false;
+    }
+    long long N = info.st_size / COMPLEX_BYTES;
+    if (N < 4 || (N & (N - 1)) != 0 || N > (1LL << 62)) {
+        std::cerr << "The out-of-core DFT needs a power-of-2 number of values, got " << N << std::endl;
+        close(input);
+        return false;
+    }
+
+    int log2N = 0;
+    while ((1LL << log2N) < N) {
+        log2N++;
+    }
+    long long R = 1LL << (log2N / 2);
+    long long C = N / R;
+    long long block_values = memory_budget / (4 * COMPLEX_BYTES);
+    if (block_values < C) {
+        std::cerr << "Memory budget too small: " << memory_budget << " bytes for " << N << " values" << std::endl;
+        close(input);
+        return false;
+    }
+    int columns_per_block = std::min<long long>(C, block_values / R);
+    int rows_per_block = std::min<long long>(R, block_values / C);
+
+    std::string scratch_file = scratch_dir + "/fft_scratch_" + std::to_string(getpid()) + ".bin";
+    int scratch = open(scratch_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    int output = open(output_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (scratch < 0 || output < 0) {
+        std::cerr << "Cannot create " << (scratch < 0 ? scratch_file : output_file) << std::endl;
+        close(input);
+        if (scratch >= 0) {
+            close(scratch);
+        }
+        if (output >= 0) {
+            close(output);
+        }
+        std::filesystem::remove(scratch_file);
+        return false;
+    }
+    bool ok = ftruncate(scratch, N * COMPLEX_BYTES) == 0 && ftruncate(output, N * COMPLEX_BYTES) == 0;
+
+    const FFTPlan& plan_R = getPlan((int)R, inverse, 1, FFTAlgorithm::Radix4);
+    const FFTPlan& plan_C = getPlan((int)C, inverse, 1, FFTAlgorithm::Radix4);
+    // w_N^m = w_C^(m / R) * w_N^(m % R): the first factor comes from the plan of size C
+    double sign = inverse ? 1.0 : -1.0;
+    std::vector<complex> fine(R);
+    for (long long k = 0; k < R; k++) {
+        fine[k] = std::polar(1.0, sign * 2 * M_PI * k / N);
+    }
+
+    ThreadPool& pool = getThreadPool();
+    long long buffer_values = std::max(R * columns_per_block, C * rows_per_block);
+    std::vector<complex> buffers[3];
+    for (int b = 0; b < 3; b++) {
+        buffers[b].resize(buffer_values);
+    }
+    std::vector<complex> transposed(buffer_values);
+
+    // Pass 1: column FFTs, twiddles, written as R rows of C values in the scratch file
+    int column_blocks = (C + columns_per_block - 1) / columns_per_block;
+    auto read_columns = [&](int block, std::vector<complex>& buffer) {
+        long long c0 = (long long)block * columns_per_block;
+        long long width = std::min<long long>(columns_per_block, C - c0);
+        for (long long r = 0; r < R; r++) {
+            if (!preadAll(input, buffer.data() + r * width, width * COMPLEX_BYTES, (r * C + c0) * COMPLEX_BYTES)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto compute_columns = [&](int block, std::vector<complex>& buffer) {
+        long long c0 = (long long)block * columns_per_block;
+        long long width = std::min<long long>(columns_per_block, C - c0);
+        pool.parallel_for(0, width, [&](int first, int last) {
+            std::vector<complex> column(R);
+            for (int b = first; b < last; b++) {
+                for (long long r = 0; r < R; r++) {
+                    column[r] = buffer[r * width + b];
+                }
+                executePlan(plan_R, column);
+                long long c = c0 + b;
+                for (long long k1 = 0; k1 < R; k1++) {
+                    long long m = c * k1;
+                    buffer[k1 * width + b] = column[k1] * plan_C.twiddle[m / R] * fine[m % R];
+                }
+            }
+        });
+    };
+    auto write_columns = [&](int block, std::vector<complex>& buffer) {
+        long long c0 = (long long)block * columns_per_block;
+        long long width = std::min<long long>(columns_per_block, C - c0);
+        for (long long k1 = 0; k1 < R; k1++) {
+            if (!pwriteAll(scratch, buffer.data() + k1 * width, width * COMPLEX_BYTES, (k1 * C + c0) * COMPLEX_BYTES)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    ok = ok && pipeline(column_blocks, buffers, read_columns, compute_columns, write_columns);
+
+    // Pass 2: row FFTs, transposed so that X[k1 + R k2] lands at its natural position
+    int row_blocks = (R + rows_per_block - 1) / rows_per_block;
+    auto read_rows = [&](int block, std::vector<complex>& buffer) {
+        long long k0 = (long long)block * rows_per_block;
+        long long height = std::min<long long>(rows_per_block, R - k0);
+        return preadAll(scratch, buffer.data(), height * C * COMPLEX_BYTES, k0 * C * COMPLEX_BYTES);
+    };
+    auto compute_rows = [&](int block, std::vector<complex>& buffer) {
+        long long k0 = (long long)block * rows_per_block;
+        long long height = std::min<long long>(rows_per_block, R - k0);
+        pool.parallel_for(0, height, [&](int first, int last) {
+            for (int r = first; r < last; r++) {
+                executePlan(plan_C, buffer.data() + r * C);
+            }
+        });
+        // The block's buffer takes the transposed values, its old storage is the next target
+        parallel_transpose(buffer.data(), transposed.data(), height, C);
+        buffer.swap(transposed);
+    };
+    auto write_rows = [&](int block, std::vector<complex>& values) {
+        long long k0 = (long long)block * rows_per_block;
+        long long height = std::min<long long>(rows_per_block, R - k0);
+        for (long long k2 = 0; k2 < C; k2++) {
+            if (!pwriteAll(output, values.data() + k2 * height, height * COMPLEX_BYTES, (k2 * R + k0) * COMPLEX_BYTES)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    ok = ok && pipeline(row_blocks, buffers, read_rows, compute_rows, write_rows);
+
+    close(input);
+    close(scratch);
+    close(output);
+    std::filesystem::remove(scratch_file);
+    if (!ok) {
+        std::cerr << "I/O error during the out-of-core DFT" << std::endl;
+    }
+    return ok;
+}
+
+
+/**
+ * @brief Runs the out-of-core DFT on a dataset written to disk, and checks it against an in-memory DFT.
+ *
+ * @param data Input vector of complex numbers (size a power of 2).
+ * @param parallel Boolean indicating whether the in-memory reference uses parallel computation.
+ * @param version Version of the DFT algorithm used for the in-memory reference.
+ * @param memory_budget Bytes the out-of-core engine may use for its blocks.
+ * @param mode "sequential" or "parallel", used in the output file name.
+ */
+void outofcore_dft(const std::vector<complex>& data, bool parallel, int version, size_t memory_budget, const std::string& mode) {
+    version = resolveVersion(data.size(), parallel, version);
+    std::string label = versionLabel(parallel, version);
+
+    std::filesystem::create_directories("plots");
+    std::string scratch_dir = std::filesystem::temp_directory_path().string();
+    std::string input_file = scratch_dir + "/fft_input_" + std::to_string(getpid()) + ".bin";
+    std::string output_file = "plots/" + mode + "_outofcore_spectrum.bin";
+    if (!writeComplexFile(input_file, data)) {
+        std::cerr << "Cannot write " << input_file << std::endl;
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    bool ok = outOfCoreDFT(input_file, output_file, scratch_dir, memory_budget, false);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::filesystem::remove(input_file);
+    if (!ok) {
+        return;
+    }
+    std::chrono::duration<double> duration = end - start;
+
+    std::vector<complex> spectrum;
+    readComplexFile(output_file, spectrum);
+    std::vector<complex> reference = data;
+    forwardDFT(reference, parallel, version);
+
+    std::cout << label << "Out-of-core DFT of " << data.size() << " values with a " << memory_budget / 1024.0 << " KiB budget, spectrum written to " << output_file << std::endl;
+    std::cout << label << "Time taken for the out-of-core DFT: " << COLOR_GREEN << duration.count() << " seconds" << COLOR_RESET << std::endl;
+    std::cout << label << "Error against the in-memory DFT: " << COLOR_ORANGE << computeAbsoluteError(reference, spectrum) << COLOR_RESET << std::endl;
+}
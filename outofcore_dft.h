@@ -0,0 +1,15 @@
+#ifndef OUTOFCORE_DFT_H
+#define OUTOFCORE_DFT_H
+
+#include <complex>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+bool writeComplexFile(const std::string& filename, const std::vector<std::complex<double>>& data);
+bool readComplexFile(const std::string& filename, std::vector<std::complex<double>>& data);
+bool outOfCoreDFT(const std::string& input_file, const std::string& output_file, const std::string& scratch_dir, size_t memory_budget, bool inverse);
+
+void outofcore_dft(const std::vector<std::complex<double>>& data, bool parallel, int version, size_t memory_budget, const std::string& mode);
+
+#endif
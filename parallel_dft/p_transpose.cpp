@@ -1,51 +1,68 @@
 #include <vector>
 #include <iostream>
 #include <complex>
+#include <algorithm>
+#include <cstdint>
 
 #include "p_transpose.h"
+#include "../core/thread_pool.h"
+#include "../core/profiler.h"
 
 
 /**
  * @brief Chooses the bit-reversal sequence based on the number of processors.
  * 
- * @param p Number of processors.
+ * sequence[i] is i with its log2(p) bits reversed, e.g. {0, 2, 1, 3} for p = 4.
+ * 
+ * @param p Number of processors (must be a power of 2).
  * @return A vector of integers representing the bit-reversal sequence.
  */
 std::vector<int> chooseSequence(int p) {
     std::vector<int> sequence;
 
-    switch (p) {
-        case 2:
-            sequence = {0, 1};
-            break;
-        case 4:
-            sequence = {0, 2, 1, 3};
-            break;
-        case 8:
-            sequence = {0, 4, 2, 6, 1, 5, 3, 7};
-            break;
-        case 16:
-            sequence = {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15};
-            break;
-        case 32:
-            sequence = {0, 16, 8, 24, 4, 20, 12, 28, 2, 18, 10, 26, 6, 22, 14, 30, 
-                        1, 17, 9, 25, 5, 21, 13, 29, 3, 19, 11, 27, 7, 23, 15, 31};
-            break;
-        case 64:
-            sequence = {0, 32, 16, 48, 8, 40, 24, 56, 4, 36, 20, 52, 12, 44, 28, 60, 
-                        2, 34, 18, 50, 10, 42, 26, 58, 6, 38, 22, 54, 14, 46, 30, 62, 
-                        1, 33, 17, 49, 9, 41, 25, 57, 5, 37, 21, 53, 13, 45, 29, 61, 
-                        3, 35, 19, 51, 11, 43, 27, 59, 7, 39, 23, 55, 15, 47, 31, 63};
-            break;
-        default:
-            std::cerr << "Unsupported value of p: " << p << std::endl;
-            break;
+    if (p < 1 || (p & (p - 1)) != 0) {
+        std::cerr << "Unsupported value of p: " << p << " (must be a power of 2)" << std::endl;
+        return sequence;
+    }
+
+    int bits = 0;
+    while ((1 << bits) < p) {
+        bits++;
+    }
+
+    sequence.resize(p);
+    for (int i = 0; i < p; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        sequence[i] = reversed;
     }
 
     return sequence;
 }
 
 
+/**
+ * @brief Chooses how many blocks the block-based parallel versions split a transform of size N into.
+ * 
+ * The block algorithm needs a power-of-two number of blocks, so this returns the smallest power
+ * of 2 that is >= num_threads (capped at N). The blocks are handed out dynamically by the thread
+ * pool, so with e.g. 24 threads all 24 cores work on the 32 blocks.
+ * 
+ * @param num_threads Number of threads available.
+ * @param N Size of the transform (a power of 2).
+ * @return The number of blocks.
+ */
+int chooseBlockCount(int num_threads, int N) {
+    int blocks = 1;
+    while (blocks < num_threads && blocks < N) {
+        blocks <<= 1;
+    }
+    return blocks;
+}
+
+
 /**
  * @brief Performs iterative bit-reversal on the input array.
  * 
@@ -54,20 +71,123 @@ std::vector<int> chooseSequence(int p) {
  * @param N Size of the input vector.
  * @return A vector of complex numbers representing the bit-reversed array.
  */
-std::vector<std::complex<double>> iterative_bit_reversal(std::vector<std::complex<double>>& input_array, int p, int N) {
-    std::vector<int> sequence = chooseSequence(p);
-    std::vector<std::complex<double>> output_array(N);
+template <typename T>
+std::vector<std::complex<T>> iterative_bit_reversal(std::vector<std::complex<T>>& input_array, int p, int N) {
+    return iterative_bit_reversal(input_array, chooseSequence(p), N);
+}
 
-    for (int i = 0; i < p; ++i) {
-        int start_index = sequence[i] * (N / p);
-        for (int j = 0; j < N / p; ++j) {
-            int index = i + j * p;
-            int input = start_index + j;
-            output_array[input] = input_array[index];
+
+/**
+ * @brief Performs iterative bit-reversal on the input array with a precomputed block sequence.
+ * 
+ * @param input_array Input vector of complex numbers.
+ * @param sequence Block sequence returned by chooseSequence (e.g. FFTPlan::block_sequence).
+ * @param N Size of the input vector.
+ * @return A vector of complex numbers representing the bit-reversed array.
+ */
+template <typename T>
+std::vector<std::complex<T>> iterative_bit_reversal(std::vector<std::complex<T>>& input_array, const std::vector<int>& sequence, int N) {
+    std::vector<std::complex<T>> output_array(N);
+    scatter_blocks(input_array.data(), output_array.data(), sequence, N);
+    return output_array;
+}
+
+
+/**
+ * @brief Scatters input into p = sequence.size() blocks: block sequence[i] receives the
+ * stride-p subsequence starting at i. Works for any element type (complex values, NTT residues).
+ * 
+ * @param input Input array of N elements.
+ * @param output Output array of N elements (must not overlap input).
+ * @param sequence Block sequence returned by chooseSequence (e.g. FFTPlan::block_sequence).
+ * @param N Size of the arrays.
+ */
+template <typename E>
+void scatter_blocks(const E* input, E* output, const std::vector<int>& sequence, int N) {
+    int p = sequence.size();
+    int block = N / p;
+
+    // The scatter is a transpose of the (N/p) x p input with its output rows permuted by sequence:
+    // walk it tile by tile so that the p output streams stay in cache
+    getThreadPool().parallel_for(0, (block + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE, [&](int tile_begin, int tile_end) {
+        PROFILE_STAGE("bit_reversal");
+        for (int tile = tile_begin; tile < tile_end; ++tile) {
+            int j_end = std::min(block, (tile + 1) * TRANSPOSE_TILE);
+            for (int i = 0; i < p; ++i) {
+                int start_index = sequence[i] * block;
+                for (int j = tile * TRANSPOSE_TILE; j < j_end; ++j) {
+                    output[start_index + j] = input[i + j * p];
+                }
+            }
+        }
+    });
+}
+
+
+
+/**
+ * @brief Transposes the tiles [tile_begin, tile_end) of rows of a rows x cols row-major matrix.
+ *
+ * Each TRANSPOSE_TILE x TRANSPOSE_TILE tile is read and written while it fits in L1, so neither
+ * the reads nor the strided writes miss on every element.
+ */
+template <typename T>
+static void transposeTiles(const std::complex<T>* input, std::complex<T>* output, int rows, int cols, int tile_begin, int tile_end) {
+    for (int tile = tile_begin; tile < tile_end; ++tile) {
+        int r0 = tile * TRANSPOSE_TILE;
+        int r1 = std::min(rows, r0 + TRANSPOSE_TILE);
+        for (int c0 = 0; c0 < cols; c0 += TRANSPOSE_TILE) {
+            int c1 = std::min(cols, c0 + TRANSPOSE_TILE);
+            for (int r = r0; r < r1; ++r) {
+                const std::complex<T>* row = input + (size_t)r * cols;
+                for (int c = c0; c < c1; ++c) {
+                    output[(size_t)c * rows + r] = row[c];
+                }
+            }
         }
-        
-       
     }
-    
-    return output_array;
 }
+
+
+/**
+ * @brief Cache-blocked out-of-place transpose on the calling thread.
+ *
+ * @param input Row-major rows x cols matrix.
+ * @param output Row-major cols x rows matrix receiving the transpose (must not alias input).
+ * @param rows Number of rows of input.
+ * @param cols Number of columns of input.
+ */
+template <typename T>
+void transpose(const std::complex<T>* input, std::complex<T>* output, int rows, int cols) {
+    transposeTiles(input, output, rows, cols, 0, (rows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE);
+}
+
+
+/**
+ * @brief Cache-blocked out-of-place transpose with the row tiles shared out over the thread pool.
+ *
+ * @param input Row-major rows x cols matrix.
+ * @param output Row-major cols x rows matrix receiving the transpose (must not alias input).
+ * @param rows Number of rows of input.
+ * @param cols Number of columns of input.
+ */
+template <typename T>
+void parallel_transpose(const std::complex<T>* input, std::complex<T>* output, int rows, int cols) {
+    getThreadPool().parallel_for(0, (rows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE, [&](int tile_begin, int tile_end) {
+        PROFILE_STAGE("transpose");
+        transposeTiles(input, output, rows, cols, tile_begin, tile_end);
+    });
+}
+
+
+template std::vector<std::complex<float>> iterative_bit_reversal<float>(std::vector<std::complex<float>>&, int, int);
+template std::vector<std::complex<double>> iterative_bit_reversal<double>(std::vector<std::complex<double>>&, int, int);
+template std::vector<std::complex<float>> iterative_bit_reversal<float>(std::vector<std::complex<float>>&, const std::vector<int>&, int);
+template std::vector<std::complex<double>> iterative_bit_reversal<double>(std::vector<std::complex<double>>&, const std::vector<int>&, int);
+template void scatter_blocks<std::complex<float>>(const std::complex<float>*, std::complex<float>*, const std::vector<int>&, int);
+template void scatter_blocks<std::complex<double>>(const std::complex<double>*, std::complex<double>*, const std::vector<int>&, int);
+template void scatter_blocks<uint32_t>(const uint32_t*, uint32_t*, const std::vector<int>&, int);
+template void transpose<float>(const std::complex<float>*, std::complex<float>*, int, int);
+template void transpose<double>(const std::complex<double>*, std::complex<double>*, int, int);
+template void parallel_transpose<float>(const std::complex<float>*, std::complex<float>*, int, int);
+template void parallel_transpose<double>(const std::complex<double>*, std::complex<double>*, int, int);
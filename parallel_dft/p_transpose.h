@@ -4,7 +4,24 @@
 #include <vector>
 #include <complex>
 
+// Side (in complex numbers) of the square tiles used by the blocked transposes: 32 x 32 x 16 bytes = 16 KB
+const int TRANSPOSE_TILE = 32;
+
 std::vector<int> chooseSequence(int p);
-std::vector<std::complex<double>> iterative_bit_reversal(std::vector<std::complex<double>>& input_array, int p, int N);
+int chooseBlockCount(int num_threads, int N);
+// Instantiated for float and double
+template <typename T>
+std::vector<std::complex<T>> iterative_bit_reversal(std::vector<std::complex<T>>& input_array, int p, int N);
+template <typename T>
+std::vector<std::complex<T>> iterative_bit_reversal(std::vector<std::complex<T>>& input_array, const std::vector<int>& sequence, int N);
+
+// Instantiated for complex<float>, complex<double> and uint32_t (NTT residues)
+template <typename E>
+void scatter_blocks(const E* input, E* output, const std::vector<int>& sequence, int N);
+
+template <typename T>
+void transpose(const std::complex<T>* input, std::complex<T>* output, int rows, int cols);
+template <typename T>
+void parallel_transpose(const std::complex<T>* input, std::complex<T>* output, int rows, int cols);
 
 #endif // P_TRANSPOSE_H
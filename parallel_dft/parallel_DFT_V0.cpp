@@ -1,15 +1,15 @@
 #include <vector>
 #include <complex>
-#include <thread>
 #include <cmath>
 #include <mutex>
 
 #include "parallel_DFT_V0.h"
 #include "../sequential_dft/sequential_DFT_V1.h"
+#include "../core/fft_plan.h"
+#include "../core/thread_pool.h"
 
 
 using complex = std::complex<double>;
-extern int p; // number of processors
 
 
 /**
@@ -21,8 +21,9 @@ extern int p; // number of processors
  * @param num_threads Number of threads to use.
  * @param N Size of the input vector.
  * @param mutex Mutex for thread synchronization.
+ * @param twiddle Precomputed twiddle factors for N.
  */
-void DFT_segments(const std::vector<complex>& array, std::vector<complex>& output, size_t start, size_t num_threads, int N, std::mutex& mutex,std::vector<std::complex<double>>  twiddle) {
+void DFT_segments(const std::vector<complex>& array, std::vector<complex>& output, size_t start, size_t num_threads, int N, std::mutex& mutex, const std::vector<std::complex<double>>& twiddle) {
     for (size_t k = start; k < N; k += num_threads) {
         complex sum = 0;
         for (size_t j = 0; j < N; ++j) {
@@ -42,48 +43,21 @@ void DFT_segments(const std::vector<complex>& array, std::vector<complex>& outpu
  */
 void DFT_parallel_V0(std::vector<complex>& array) {
     int N = array.size();
-    size_t num_threads = p;
+    size_t num_threads = getThreadPool().size();
     if (num_threads == 1) {
         DFT_V1(array, N);
         return;
     }
 
-    int block_size = N / num_threads;
-
-    // COMPUTATION IN PARALLEL OF THE TWIDDLE FACTORS
-    std::vector<std::thread> workers_twiddle(num_threads);
-    std::vector<std::complex<double>> twiddle(N);
-
-    int begin_twiddle = 0;
-    int end_twiddle = block_size;
-    
-    for (int i = 0; i < num_threads; i++){
-        workers_twiddle[i] = std::thread([begin_twiddle, end_twiddle, &twiddle, N]() {
-            for (int j = begin_twiddle; j < end_twiddle; ++j) {
-               twiddle[j]= std::polar(1.0, - 2 * M_PI * j / N);
-             }});
-
-        begin_twiddle += block_size;
-        end_twiddle += block_size;}
-
-    for (size_t i = 0; i < num_threads; ++i) {
-        workers_twiddle[i].join();
-    }
-    
-    std::vector<std::thread> threads;
-    threads.reserve(num_threads - 1);
+    // Twiddle factors come from the sequential plan for N, shared by every pool size
+    const std::vector<std::complex<double>>& twiddle = getPlan(N, false, 1).twiddle;
 
     std::vector<complex> output(N);
     std::mutex mutex;
 
-    for (size_t i = 1; i < num_threads; ++i) {
-        threads.emplace_back(DFT_segments, std::cref(array), std::ref(output), i, num_threads, N, std::ref(mutex), twiddle);
-    }
-    DFT_segments(array, output, 0, num_threads, N, mutex,twiddle);
-
-    for (auto& thread : threads) {
-        thread.join();
-    }
+    getThreadPool().run(num_threads, [&](int i) {
+        DFT_segments(array, output, i, num_threads, N, mutex, twiddle);
+    });
 
     array = output;
 }
@@ -98,15 +72,16 @@ void DFT_parallel_V0(std::vector<complex>& array) {
  * @param num_threads Number of threads to use.
  * @param N Size of the input vector.
  * @param mutex Mutex for thread synchronization.
+ * @param twiddle Precomputed twiddle factors for N.
  */
-void invDFT_segments(const std::vector<complex>& array, std::vector<complex>& output, size_t start, size_t num_threads, int N, std::mutex& mutex, std::vector<std::complex<double>> twiddle) {
+void invDFT_segments(const std::vector<complex>& array, std::vector<complex>& output, size_t start, size_t num_threads, int N, std::mutex& mutex, const std::vector<std::complex<double>>& twiddle) {
     for (size_t k = start; k < N; k += num_threads) {
         complex sum = 0;
         for (size_t j = 0; j < N; ++j) {
             sum += std::conj(array[j]) * twiddle[(j*k)%N];
         }
         std::lock_guard<std::mutex> lock(mutex);
-        output[k] = sum / (1.0*N);
+        output[k] = std::conj(sum) / (1.0*N);
     }
 }
 
@@ -120,49 +95,21 @@ void invDFT_segments(const std::vector<complex>& array, std::vector<complex>& ou
 
 void invDFT_parallel_V0(std::vector<complex>& array) {
     int N = array.size();
-    size_t num_threads = p;
+    size_t num_threads = getThreadPool().size();
     if (num_threads == 1) {
         invDFT_V1(array);
         return;
     }
 
-    int block_size = N / num_threads;
-
-    // COMPUTATION IN PARALLEL OF THE TWIDDLE FACTORS
-    std::vector<std::thread> workers_twiddle(num_threads);
-    std::vector<std::complex<double>>  twiddle(N);
-
-    int begin_twiddle =0;
-    int end_twiddle= block_size;
-    
-    for (int i = 0; i < num_threads; i++){
-        workers_twiddle[i] = std::thread([begin_twiddle, end_twiddle, &twiddle,N]() {
-            for (int j = begin_twiddle; j < end_twiddle; ++j) {
-               twiddle[j]= std::polar(1.0,  - 2 * M_PI * j / N);
-             }});
-
-        begin_twiddle += block_size;
-        end_twiddle += block_size;}
-    
-
-    for (size_t i = 0; i < num_threads ; ++i) {
-        workers_twiddle[i].join();
-    }
-
-    std::vector<std::thread> threads;
-    threads.reserve(num_threads - 1);
+    // Twiddle factors come from the sequential plan for N, shared by every pool size
+    const std::vector<std::complex<double>>& twiddle = getPlan(N, false, 1).twiddle;
 
     std::vector<complex> output(N);
     std::mutex mutex;
 
-    for (size_t i = 1; i < num_threads; ++i) {
-        threads.emplace_back(invDFT_segments, std::cref(array), std::ref(output), i, num_threads, N, std::ref(mutex),twiddle);
-    }
-    invDFT_segments(array, output, 0, num_threads, N, mutex,twiddle);
-
-    for (auto& thread : threads) {
-        thread.join();
-    }
+    getThreadPool().run(num_threads, [&](int i) {
+        invDFT_segments(array, output, i, num_threads, N, mutex, twiddle);
+    });
 
     array = output;
 }
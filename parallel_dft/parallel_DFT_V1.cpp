@@ -1,105 +1,123 @@
 #include <complex>
 #include <vector>
-#include <thread>
 #include <cmath>
+#include <algorithm>
 #include <mutex>
 
 #include "parallel_DFT_V1.h"
-#include "../sequential_dft/sequential_DFT_V1.h"
 #include "p_transpose.h"
-
-
-extern int p; // number of processors
+#include "../core/thread_pool.h"
+#include "../core/profiler.h"
 
 
 /**
- * @brief Worker function for computing the DFT of a segment of data.
+ * @brief Worker function for computing the DFT of a segment of data, in place in the shared buffer.
  * 
- * @param begin Starting index for the segment.
- * @param end Ending index for the segment.
- * @param result Output vector to store the results.
- * @param data Input vector of complex numbers.
+ * Iterative radix-2 FFT: an in-place bit-reversal permutation, then log2(n) butterfly stages.
+ * As everywhere in version 1, the twiddle factors are computed on the fly (once per butterfly
+ * column of each stage, n - 1 in total) rather than read from a table.
+ * 
+ * @param block Pointer to the first value of the segment.
+ * @param n Size of the segment (a power of 2).
  */
-void workerDFT_V1(int begin, int end,std::vector<std::complex<double>>& result, std::vector<std::complex<double>>&  data){
-    int n = end - begin;
-    std::vector<std::complex<double>> temp(n);
+void workerDFT_V1(std::complex<double>* block, int n) {
+    PROFILE_STAGE("leaf_dft");
 
-    for (int i = 0; i < n; i++){
-        temp[i] = data[i+begin];
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(block[i], block[j]);
+        }
     }
 
-    DFT_V1(temp,n);
-
-    for (int i = 0; i < n; i++){
-        result[i+begin] = temp[i];
+    for (int len = 2; len <= n; len <<= 1) {
+        int half = len / 2;
+        for (int j = 0; j < half; j++) {
+            std::complex<double> twiddle = std::polar(1.0, - 2 * M_PI * j / len);
+            for (int i = j; i < n; i += len) {
+                std::complex<double> G = block[i];
+                std::complex<double> H = twiddle * block[i + half];
+                block[i] = G + H;
+                block[i + half] = G - H;
+            }
+        }
     }
 }
 
 
 /**
- * @brief Main function for performing the parallel DFT.
+ * @brief Runs the radix-2 combine stages that merge the leaf DFTs, on the whole thread pool.
  * 
- * @param array Input vector of complex numbers.
- * @param results Output vector to store the results.
+ * Within each stage the N/2 butterflies are split evenly between the threads, and a barrier
+ * separates consecutive stages. As everywhere in version 1, the twiddle factors are computed
+ * on the fly rather than precomputed.
+ * 
+ * @param results Vector holding the leaf DFTs (blocks of block_size values), combined in place.
  * @param N Size of the input vector.
- * @param num_threads Number of threads to use.
+ * @param block_size Size of the leaf blocks.
  */
-void mainDFT_V1(std::vector<std::complex<double>>& array, std::vector<std::complex<double>>& results, int N, int num_threads) {
-
-    int block_size = N / num_threads;
-    std::vector<std::complex<double>> array_rec(array);
-    std::vector<std::complex<double>> array_ite(array);
-    std::vector<std::complex<double>> output_rec(array);
-    std::vector<std::complex<double>> output(N);
-
-    std::vector<std::thread> workers(num_threads);
-    int begin = 0;
-    int end = block_size;
-
-    for (int i = 0; i < num_threads; i++){
-        workers[i] = std::thread(&workerDFT_V1, begin, end, std::ref(results), std::ref(array));
-        begin += block_size;
-        end += block_size;
-    }
-
-    for (size_t i = 0; i < num_threads ; ++i) {
-        workers[i].join();
+void combineStages_V1(std::vector<std::complex<double>>& results, int N, int block_size) {
+    if (block_size >= N) {
+        return;
     }
 
-    int block_size2 = N/num_threads*2;
-    
-    for (int thread=0; thread < log2(num_threads); thread++){
-        int begin,end;
-        begin = 0;
-        end = block_size2;
+    ThreadPool& pool = getThreadPool();
+    int team = std::min(pool.teamSize(), N / 2);
+    Barrier barrier(team);
 
-      
-        while (end <= N){
+    pool.run(team, [&](int t) {
+        PROFILE_STAGE("combine");
+        int first = (long long) (N / 2) * t / team;
+        int last = (long long) (N / 2) * (t + 1) / team;
 
-            std::vector<std::complex<double>>  G_N(block_size2 /2), H_N(block_size2 /2);
-            std::complex<double>  twiddle;
+        for (int len = 2 * block_size; len <= N; len <<= 1) {
+            int half = len / 2;
 
-            for (int i = 0; i< block_size2 /2; i++){
-                twiddle = std::polar(1.0,  - 2 * M_PI * i / N);
-                G_N[i] = results[begin+ i];
-                H_N[i] = results[begin +i + block_size2/2];
+            for (int b = first; b < last; b++) {
+                int j = b & (half - 1);
+                int i = 2 * (b - j) + j;
 
-                results[begin + i] = G_N[i] +  twiddle *H_N[i];
-                results[begin + i + block_size2/2] = G_N[i] - twiddle*H_N[i];
+                std::complex<double> twiddle = std::polar(1.0, - 2 * M_PI * j / len);
+                std::complex<double> G = results[i];
+                std::complex<double> H = twiddle * results[i + half];
+                results[i] = G + H;
+                results[i + half] = G - H;
             }
 
+            barrier.wait();
+        }
+    });
+}
 
 
-            begin += block_size2;
-            end += block_size2;
-        }
+/**
+ * @brief Main function for performing the parallel DFT.
+ * 
+ * The input is first scattered so that block b holds the stride-num_threads subsequence bitrev(b).
+ * Each block is then transformed independently, and the log2(num_threads) remaining radix-2
+ * stages combine the blocks into the full DFT.
+ * 
+ * @param array Input vector of complex numbers.
+ * @param results Output vector to store the results (may be the same vector as array).
+ * @param N Size of the input vector.
+ * @param num_threads Number of blocks (a power of 2, see chooseBlockCount), shared out over the thread pool.
+ */
+void mainDFT_V1(std::vector<std::complex<double>>& array, std::vector<std::complex<double>>& results, int N, int num_threads) {
+    PROFILE_STAGE("parallel_V1");
+    int block_size = N / num_threads;
 
-        block_size2 *=2;
+    results = iterative_bit_reversal(array, num_threads, N);
 
-    }
-    results = iterative_bit_reversal(results, num_threads, N);
+    getThreadPool().run(num_threads, [&](int i) {
+        workerDFT_V1(results.data() + (size_t)i * block_size, block_size);
+    });
 
-    }
+    combineStages_V1(results, N, block_size);
+}
 
 
 /**
@@ -109,11 +127,7 @@ void mainDFT_V1(std::vector<std::complex<double>>& array, std::vector<std::compl
  */
 void DFT_parallel_V1(std::vector<std::complex<double>>& dft){
     int N = dft.size();
-    std::vector<std::complex<double>> data_copy(N) ;
-    for (int i=0; i < N; i++){
-        data_copy[i]= dft[i];
-    }
-    mainDFT_V1(data_copy, dft , N, p);
+    mainDFT_V1(dft, dft , N, chooseBlockCount(getThreadPool().size(), N));
 }
 
 
@@ -124,15 +138,14 @@ void DFT_parallel_V1(std::vector<std::complex<double>>& dft){
  */
 void invDFT_parallel_V1(std::vector<std::complex<double>>& data){
     int N = data.size() ;
-    std::vector<std::complex<double>> data_copy(N) ;
 
     for (int i=0; i < N; i++){
-        data_copy[i]= std::conj(data[i]);
+        data[i]= std::conj(data[i]);
     }
 
-    mainDFT_V1(data_copy, data , N, p);
+    mainDFT_V1(data, data , N, chooseBlockCount(getThreadPool().size(), N));
 
     for (int i=0; i < N; i++){
-        data[i]= data[i] / (1.0 *N);
+        data[i]= std::conj(data[i]) / (1.0 *N);
     }
 }
@@ -1,136 +1,132 @@
 #include <complex>
 #include <vector>
-#include <thread>
 #include <cmath>
+#include <algorithm>
 
 #include "parallel_DFT_V2.h"
-#include "../sequential_dft/sequential_DFT_V1.h"
 #include "p_transpose.h"
-
-extern int p; // number of processors
-
-
-void workerDFT(int begin, int end,std::vector<std::complex<double>>& result, std::vector<std::complex<double>>&  data){
-    int n = end - begin;
-
-    std::vector<std::complex<double>> temp(n);
-
-    for (int i = 0; i < n; i++){
-        temp[i] = data[i+begin];
-    }
-
-
-    DFT_V1(temp,n);
-    
-    for (int i = 0; i < n; i++){
-        result[i+begin] = temp[i];
-    }
-    
+#include "../core/thread_pool.h"
+#include "../core/fft_plan.h"
+#include "../core/profiler.h"
+
+
+/**
+ * @brief Worker function for computing the DFT of one leaf block, in place in the shared buffer.
+ * 
+ * @param leaf_plan Cached plan for the block size (radix-4, precomputed twiddles and permutation).
+ * @param block Pointer to the first value of the block.
+ */
+template <typename T>
+void workerDFT(const FFTPlanT<T>& leaf_plan, std::complex<T>* block) {
+    PROFILE_STAGE("leaf_dft");
+    executePlan(leaf_plan, block);
 }
 
 
-
-
-
-void mainDFT(std::vector<std::complex<double>>& array, std::vector<std::complex<double>>& results,int N, int num_threads) {
-    int block_size = N / num_threads;
-
-    
-    // COMPUTATION IN PARALLEL OF THE TWIDDLE FACTORS
-    std::vector<std::thread> workers_twiddle(num_threads - 1);
-    std::vector<std::complex<double>>  twiddle(N);
-
-    int begin_twiddle =0;
-    int end_twiddle= block_size;
-    
-    for (int i = 0; i < num_threads; i++){
-        workers_twiddle[i] = std::thread([begin_twiddle, end_twiddle, &twiddle,N]() {
-            for (int j = begin_twiddle; j < end_twiddle; ++j) {
-               twiddle[j]= std::polar(1.0,  - 2 * M_PI * j / N);
-             }});
-
-        begin_twiddle += block_size;
-        end_twiddle += block_size;}
-    
-
-    for (size_t i = 0; i < num_threads ; ++i) {
-        workers_twiddle[i].join();
+/**
+ * @brief Runs the radix-2 combine stages that merge the leaf DFTs, on the whole thread pool.
+ * 
+ * Within each stage the N/2 butterflies are split evenly between the threads, and a barrier
+ * separates consecutive stages. The butterflies work in place on results, so nothing is allocated.
+ * 
+ * @param results Vector holding the leaf DFTs (blocks of block_size values), combined in place.
+ * @param N Size of the input vector.
+ * @param block_size Size of the leaf blocks.
+ * @param twiddle Precomputed twiddle factors for N.
+ */
+template <typename T>
+void combineStages(std::vector<std::complex<T>>& results, int N, int block_size, const std::vector<std::complex<T>>& twiddle) {
+    if (block_size >= N) {
+        return;
     }
 
-    
+    ThreadPool& pool = getThreadPool();
+    int team = std::min(pool.teamSize(), N / 2);
+    Barrier barrier(team);
 
-    // COMPUTATION IN PARALLEL OF DFT CHUNKS
-    std::vector<std::thread> workers(num_threads);
-
-    int begin =0;
-    int end = block_size;
+    pool.run(team, [&](int t) {
+        PROFILE_STAGE("combine");
+        int first = (long long) (N / 2) * t / team;
+        int last = (long long) (N / 2) * (t + 1) / team;
 
-    for (int i = 0; i < num_threads; i++){
-        workers[i] = std::thread(&workerDFT, begin, end, std::ref(results), std::ref(array));
-        begin += block_size;
-        end += block_size;
-    }
+        for (int len = 2 * block_size; len <= N; len <<= 1) {
+            int half = len / 2;
+            int stride = N / len;
 
-    for (size_t i = 0; i < num_threads ; ++i) {
-        workers[i].join();
-    }
+            for (int b = first; b < last; b++) {
+                int j = b & (half - 1);
+                int i = 2 * (b - j) + j;
 
-
-
-
-    // ASSEMBLING EVERYTHING
-    int block_size2 = N/num_threads*2;
-    // pas sûre ----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-    for (int thread=0; thread < log2(num_threads); thread++){
-        int begin,end;
-        begin = 0;
-        end = block_size2;
-        while (end <= N){
-
-            std::vector<std::complex<double>>  G_N(block_size2 /2), H_N(block_size2 /2);
-
-
-            for (int i = 0; i< block_size2 /2; i++){
-                G_N[i] = results[begin+ i];
-                H_N[i] = results[begin +i + block_size2/2];
-
-                results[begin + i] = G_N[i] +  twiddle[i] *H_N[i];
-                results[begin + i + block_size2/2] = G_N[i] - twiddle[i] *H_N[i];
+                std::complex<T> G = results[i];
+                std::complex<T> H = twiddle[j * stride] * results[i + half];
+                results[i] = G + H;
+                results[i + half] = G - H;
             }
 
-
-            begin += block_size2;
-            end += block_size2;
+            barrier.wait();
         }
-        block_size2 *=2;
-        
+    });
+}
+
+
+/**
+ * @brief Main function for performing the parallel DFT.
+ * 
+ * The input is first scattered so that block b holds the stride-num_threads subsequence bitrev(b).
+ * Each block is then transformed independently, and the log2(num_threads) remaining radix-2
+ * stages combine the blocks into the full DFT.
+ * 
+ * @param array Input vector of complex numbers.
+ * @param results Output vector to store the results (may be the same vector as array).
+ * @param N Size of the input vector.
+ * @param num_threads Number of blocks (a power of 2, see chooseBlockCount), shared out over the thread pool.
+ */
+template <typename T>
+void mainDFT(std::vector<std::complex<T>>& array, std::vector<std::complex<T>>& results,int N, int num_threads) {
+    PROFILE_STAGE("parallel_V2");
+    int block_size = N / num_threads;
 
-    } 
+    // TWIDDLE FACTORS FROM THE SEQUENTIAL PLAN FOR N, SHARED BY EVERY BLOCK COUNT
+    const std::vector<std::complex<T>>& twiddle = getPlan<T>(N, false, 1).twiddle;
 
-    results = iterative_bit_reversal(results, num_threads, N);
+    const FFTPlanT<T>& leaf_plan = getPlan<T>(block_size, false, 1, FFTAlgorithm::Radix4);
 
+    results = iterative_bit_reversal(array, num_threads, N);
 
-   //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    // COMPUTATION IN PARALLEL OF DFT CHUNKS
+    getThreadPool().run(num_threads, [&](int i) {
+        workerDFT(leaf_plan, results.data() + (size_t)i * block_size);
+    });
 
+    // ASSEMBLING EVERYTHING
+    combineStages(results, N, block_size, twiddle);
 }
 
-void DFT_parallel_V2(std::vector<std::complex<double>>& dft){
+template <typename T>
+void DFT_parallel_V2(std::vector<std::complex<T>>& dft){
     int N = dft.size();
-    mainDFT(dft, dft , N, p);
+    mainDFT(dft, dft , N, chooseBlockCount(getThreadPool().size(), N));
 }
 
 
-void invDFT_parallel_V2(std::vector<std::complex<double>>& data){
+template <typename T>
+void invDFT_parallel_V2(std::vector<std::complex<T>>& data){
     int N = data.size() ;
 
     for (int i=0; i < N; i++){
         data[i]= std::conj(data[i]);
     }
 
-    mainDFT(data, data , N, p);
+    mainDFT(data, data , N, chooseBlockCount(getThreadPool().size(), N));
 
     for (int i=0; i < N; i++){
-        data[i]= data[i] / (1.0 *N);
+        data[i]= std::conj(data[i]) / T(N);
     }
 
 }
+
+
+template void DFT_parallel_V2<float>(std::vector<std::complex<float>>& dft);
+template void DFT_parallel_V2<double>(std::vector<std::complex<double>>& dft);
+template void invDFT_parallel_V2<float>(std::vector<std::complex<float>>& data);
+template void invDFT_parallel_V2<double>(std::vector<std::complex<double>>& data);
@@ -4,7 +4,10 @@
 #include <complex>
 #include <vector>
 
-void DFT_parallel_V2(std::vector<std::complex<double>>& dft);
-void invDFT_parallel_V2(std::vector<std::complex<double>>& data);
+// Instantiated for float and double
+template <typename T>
+void DFT_parallel_V2(std::vector<std::complex<T>>& dft);
+template <typename T>
+void invDFT_parallel_V2(std::vector<std::complex<T>>& data);
 
 #endif
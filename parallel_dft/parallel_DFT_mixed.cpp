@@ -0,0 +1,130 @@
+#include <complex>
+#include <vector>
+#include <cmath>
+
+#include "parallel_DFT_mixed.h"
+#include "../sequential_dft/sequential_DFT_mixed.h"
+#include "../sequential_dft/sequential_DFT_bluestein.h"
+#include "../core/fft_plan.h"
+#include "../core/thread_pool.h"
+
+using complex = std::complex<double>;
+
+
+/**
+ * @brief Main function for performing the parallel mixed-radix DFT.
+ * 
+ * The first L radices are peeled off until there are at least as many independent sub-transforms
+ * as threads. Those sub-transforms run on the pool with the sequential mixed_work, then the L
+ * peeled stages are applied level by level, with the butterflies of each level split across the pool.
+ * 
+ * @param output Output vector (size N).
+ * @param input Input vector (size N, must not be the same vector as output).
+ * @param N Size of the transform.
+ */
+void mainDFT_mixed(std::vector<complex>& output, const std::vector<complex>& input, int N) {
+    ThreadPool& pool = getThreadPool();
+    const FFTPlan& plan = getPlan(N, false, 1);
+    const complex* twiddle = plan.twiddle.data();
+    std::vector<int> factors = mixedRadixFactors(N);
+
+    int levels = factors.size() / 2;
+    int split = 0;     // number of peeled levels
+    int subproblems = 1;
+    std::vector<int> weight;  // weight[l] = product of the radices before level l
+    while (split < levels && subproblems < pool.size()) {
+        weight.push_back(subproblems);
+        subproblems *= factors[2 * split];
+        split++;
+    }
+    int sub_length = N / subproblems;
+
+    // COMPUTATION IN PARALLEL OF THE SUB-TRANSFORMS
+    // Sub-transform s (digits j_0 .. j_{split-1}, j_0 most significant) lives at output[s * sub_length]
+    // and starts at input[sum j_l * weight[l]], reading every subproblems-th value from there.
+    pool.run(subproblems, [&](int s) {
+        int offset = 0;
+        int digits = s;
+        for (int l = split - 1; l >= 0; l--) {
+            int radix = factors[2 * l];
+            offset += (digits % radix) * weight[l];
+            digits /= radix;
+        }
+
+        if (split == levels) {
+            output[s] = input[offset];
+        } else {
+            mixed_work(output.data() + s * sub_length, input.data() + offset, subproblems, factors.data() + 2 * split, twiddle, N);
+        }
+    });
+
+    // ASSEMBLING THE PEELED LEVELS
+    for (int l = split - 1; l >= 0; l--) {
+        int radix = factors[2 * l];
+        int m = factors[2 * l + 1];
+        subproblems /= radix;
+        int fstride = subproblems;
+        int length = radix * m;
+
+        pool.parallel_for(0, subproblems * m, [&](int begin, int end) {
+            for (int b = begin; b < end; b++) {
+                int s = b / m;
+                int u = b % m;
+                mixed_butterfly(output.data() + s * length, u, fstride, m, radix, twiddle, N);
+            }
+        });
+    }
+}
+
+
+/**
+ * @brief Performs the Discrete Fourier Transform (DFT) on a given input vector of any size using parallel processing (mixed radix).
+ * 
+ * Sizes with a prime factor above BLUESTEIN_MIN_RADIX go through Bluestein's algorithm, with the
+ * power-of-2 convolution run by the parallel version 2.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ */
+void DFT_parallel_mixed(std::vector<complex>& data) {
+    int N = data.size();
+    if (N <= 1) {
+        return;
+    }
+
+    if (largestRadix(mixedRadixFactors(N)) > BLUESTEIN_MIN_RADIX) {
+        bluestein(data, true);
+        return;
+    }
+
+    std::vector<complex> input(data);
+    mainDFT_mixed(data, input, N);
+}
+
+
+/**
+ * @brief Performs the Inverse Discrete Fourier Transform (IDFT) on a given input vector of any size using parallel processing (mixed radix).
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ */
+void invDFT_parallel_mixed(std::vector<complex>& data) {
+    int N = data.size();
+    if (N <= 1) {
+        return;
+    }
+
+    std::vector<complex> input(N);
+    for (int i = 0; i < N; i++) {
+        input[i] = std::conj(data[i]);
+    }
+
+    if (largestRadix(mixedRadixFactors(N)) > BLUESTEIN_MIN_RADIX) {
+        bluestein(input, true);
+        data = input;
+    } else {
+        mainDFT_mixed(data, input, N);
+    }
+
+    for (int i = 0; i < N; i++) {
+        data[i] = std::conj(data[i]) / (1.0 * N);
+    }
+}
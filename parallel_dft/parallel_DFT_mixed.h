@@ -0,0 +1,10 @@
+#ifndef PARALLEL_DFT_MIXED_H
+#define PARALLEL_DFT_MIXED_H
+
+#include <complex>
+#include <vector>
+
+void DFT_parallel_mixed(std::vector<std::complex<double>>& data);
+void invDFT_parallel_mixed(std::vector<std::complex<double>>& data);
+
+#endif
@@ -0,0 +1,162 @@
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "parallel_DFT_sixstep.h"
+#include "p_transpose.h"
+#include "../core/thread_pool.h"
+#include "../core/fft_plan.h"
+#include "../core/profiler.h"
+
+
+/**
+ * @brief Shape and twiddle tables of a six-step transform of size N = R * C.
+ * 
+ * R = 2^floor(log2(N)/2) <= C, so both row lengths stay close to sqrt(N) and a row fits in cache.
+ * The twiddle w_N^m (m < N) is split as w_C^(m / R) * w_N^(m % R): the first factor is read
+ * from the plan of size C and fine[] holds the second one, so no table of size N is needed.
+ */
+template <typename T>
+struct SixStepTables {
+    int R;
+    int C;
+    std::vector<std::complex<T>> fine;
+};
+
+template <typename T>
+using SixStepCache = std::map<std::pair<int, bool>, std::unique_ptr<SixStepTables<T>>>;
+
+// One cache per precision, both guarded by the same mutex
+template <typename T>
+static SixStepCache<T>& sixstepCache() {
+    static SixStepCache<T> cache;
+    return cache;
+}
+static std::mutex sixstep_cache_mutex;
+
+
+template <typename T>
+static const SixStepTables<T>& getSixStepTables(int N, bool inverse) {
+    std::lock_guard<std::mutex> lock(sixstep_cache_mutex);
+
+    SixStepCache<T>& sixstep_cache = sixstepCache<T>();
+    auto key = std::make_pair(N, inverse);
+    auto it = sixstep_cache.find(key);
+    if (it != sixstep_cache.end()) {
+        return *it->second;
+    }
+
+    PROFILE_STAGE("twiddles");
+    auto tables = std::make_unique<SixStepTables<T>>();
+    int log2N = 0;
+    while ((1 << log2N) < N) {
+        log2N++;
+    }
+    tables->R = 1 << (log2N / 2);
+    tables->C = N / tables->R;
+
+    double sign = inverse ? 1.0 : -1.0;
+    tables->fine.resize(tables->R);
+    for (int k = 0; k < tables->R; k++) {
+        tables->fine[k] = std::complex<T>(std::polar(1.0, sign * 2 * M_PI * k / N));
+    }
+
+    return *sixstep_cache.emplace(key, std::move(tables)).first->second;
+}
+
+
+/**
+ * @brief Six-step FFT of a power-of-2 size, with every step shared out over the thread pool.
+ * 
+ * With n = r*C + c and k = k1 + R*k2, X[k] = sum_c w_C^(c k2) w_N^(c k1) sum_r w_R^(r k1) x[r*C + c]:
+ *  1. transpose the R x C input so that each column c becomes a contiguous row,
+ *  2. FFT of length R on each of these C rows,
+ *  3. multiply entry (c, k1) by w_N^(c k1),
+ *  4. transpose back to R x C,
+ *  5. FFT of length C on each of the R rows,
+ *  6. transpose so that X[k1 + R*k2] lands at its natural index.
+ * Every pass touches contiguous rows or cache-sized tiles, unlike the stride-doubling radix-2
+ * stages, which miss in cache and TLB once N is past the L2/L3 size.
+ * 
+ * @param data Input vector of complex numbers (size a power of 2). The transformed data will be stored back in this vector.
+ * @param inverse True for the inverse transform (conjugated twiddles and 1/N scaling, split as 1/R and 1/C over the row FFTs).
+ */
+template <typename T>
+static void sixstep(std::vector<std::complex<T>>& data, bool inverse) {
+    using complex = std::complex<T>;
+
+    int N = data.size();
+    if (N <= 4) {
+        executePlan(getPlan<T>(N, inverse, 1), data);
+        return;
+    }
+
+    PROFILE_STAGE("sixstep");
+    const SixStepTables<T>& tables = getSixStepTables<T>(N, inverse);
+    int R = tables.R;
+    int C = tables.C;
+    const FFTPlanT<T>& plan_R = getPlan<T>(R, inverse, 1, FFTAlgorithm::Radix4);
+    const FFTPlanT<T>& plan_C = getPlan<T>(C, inverse, 1, FFTAlgorithm::Radix4);
+
+    ThreadPool& pool = getThreadPool();
+    std::vector<complex> work(N);
+
+    // Steps 1-3
+    parallel_transpose(data.data(), work.data(), R, C);
+    pool.parallel_for(0, C, [&](int begin, int end) {
+        PROFILE_STAGE("row_fft");
+        for (int c = begin; c < end; c++) {
+            complex* row = work.data() + (size_t)c * R;
+            executePlan(plan_R, row);
+            for (int k1 = 1; k1 < R; k1++) {
+                int m = c * k1;
+                row[k1] *= plan_C.twiddle[m / R] * tables.fine[m % R];
+            }
+        }
+    });
+
+    // Steps 4-5
+    parallel_transpose(work.data(), data.data(), C, R);
+    pool.parallel_for(0, R, [&](int begin, int end) {
+        PROFILE_STAGE("row_fft");
+        for (int r = begin; r < end; r++) {
+            executePlan(plan_C, data.data() + (size_t)r * C);
+        }
+    });
+
+    // Step 6
+    parallel_transpose(data.data(), work.data(), R, C);
+    data.swap(work);
+}
+
+
+/**
+ * @brief Performs the Discrete Fourier Transform (DFT) with the cache-blocked six-step algorithm.
+ * 
+ * @param data Input vector of complex numbers (size a power of 2). The transformed data will be stored back in this vector.
+ */
+template <typename T>
+void DFT_parallel_sixstep(std::vector<std::complex<T>>& data) {
+    sixstep(data, false);
+}
+
+
+/**
+ * @brief Performs the Inverse Discrete Fourier Transform (IDFT) with the cache-blocked six-step algorithm.
+ * 
+ * @param data Input vector of complex numbers (size a power of 2). The transformed data will be stored back in this vector.
+ */
+template <typename T>
+void invDFT_parallel_sixstep(std::vector<std::complex<T>>& data) {
+    sixstep(data, true);
+}
+
+
+template void DFT_parallel_sixstep<float>(std::vector<std::complex<float>>& data);
+template void DFT_parallel_sixstep<double>(std::vector<std::complex<double>>& data);
+template void invDFT_parallel_sixstep<float>(std::vector<std::complex<float>>& data);
+template void invDFT_parallel_sixstep<double>(std::vector<std::complex<double>>& data);
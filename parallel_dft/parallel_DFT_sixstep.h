@@ -0,0 +1,13 @@
+#ifndef PARALLEL_DFT_SIXSTEP_H
+#define PARALLEL_DFT_SIXSTEP_H
+
+#include <complex>
+#include <vector>
+
+// Instantiated for float and double
+template <typename T>
+void DFT_parallel_sixstep(std::vector<std::complex<T>>& data);
+template <typename T>
+void invDFT_parallel_sixstep(std::vector<std::complex<T>>& data);
+
+#endif
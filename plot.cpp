@@ -11,25 +11,10 @@
 #include <sstream>
 
 #include "plot.h"
+#include "dft_versions.h"
 
-void plot_DFT(const std::vector<std::complex<double>>& original_data, const std::vector<std::complex<double>>& modified_data, const std::string& mode, const std::string& computation, int version) {
-    int n = original_data.size();
-
-    std::vector<double> x(n), real_original(n), real_modified(n);
-    for (int i = 0; i < n; i++) {
-        x[i] = i + 1;
-        real_original[i] = original_data[i].real();
-        real_modified[i] = modified_data[i].real();
-    }
-
-    std::ofstream dataFile("Plots/data_values.csv"); // save data to csv file if we want to check it
-    dataFile << "Index, original_data, real_original, DFT_data, real_DFT\n";
-    for (int i = 0; i < n; i++) {
-        dataFile << x[i] << "; "
-                 << original_data[i] << "; " << real_original[i] << "; "
-                 << modified_data[i] << "; " << real_modified[i] << "\n";
-    }
-    dataFile.close();
+static void drawDFTComparison(const std::vector<double>& x, const std::vector<double>& real_original, const std::vector<double>& real_modified, const std::string& mode, const std::string& computation, int version) {
+    int n = x.size();
 
     TGraph *gr1 = new TGraph();
     TGraph *gr2 = new TGraph();
@@ -57,19 +42,59 @@ void plot_DFT(const std::vector<std::complex<double>>& original_data, const std:
     mg->Draw("A");
     
     std::ostringstream title;
-    title << mode << " " << computation << " using V" << version;
+    title << mode << " " << computation << " using V" << versionName(version);
     mg->SetTitle(title.str().c_str());
     
     mg->GetXaxis()->SetTitle("Days");
     mg->GetYaxis()->SetTitle("Measured Temperature");
 
     std::ostringstream oss;
-    oss << "plots/" << mode << "_" << computation << "_V" << version << ".png";
+    oss << "plots/" << mode << "_" << computation << "_V" << versionName(version) << ".png";
     std::string filename = oss.str();
 
     c->SaveAs(filename.c_str());
 }
 
+void plot_DFT(const std::vector<std::complex<double>>& original_data, const std::vector<std::complex<double>>& modified_data, const std::string& mode, const std::string& computation, int version) {
+    int n = original_data.size();
+
+    std::vector<double> x(n), real_original(n), real_modified(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = i + 1;
+        real_original[i] = original_data[i].real();
+        real_modified[i] = modified_data[i].real();
+    }
+
+    std::ofstream dataFile("Plots/data_values.csv"); // save data to csv file if we want to check it
+    dataFile << "Index, original_data, real_original, DFT_data, real_DFT\n";
+    for (int i = 0; i < n; i++) {
+        dataFile << x[i] << "; "
+                 << original_data[i] << "; " << real_original[i] << "; "
+                 << modified_data[i] << "; " << real_modified[i] << "\n";
+    }
+    dataFile.close();
+
+    drawDFTComparison(x, real_original, real_modified, mode, computation, version);
+}
+
+void plot_DFT(const std::vector<double>& original_data, const std::vector<double>& modified_data, const std::string& mode, const std::string& computation, int version) {
+    int n = original_data.size();
+
+    std::vector<double> x(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = i + 1;
+    }
+
+    std::ofstream dataFile("Plots/data_values.csv"); // save data to csv file if we want to check it
+    dataFile << "Index, original_data, DFT_data\n";
+    for (int i = 0; i < n; i++) {
+        dataFile << x[i] << "; " << original_data[i] << "; " << modified_data[i] << "\n";
+    }
+    dataFile.close();
+
+    drawDFTComparison(x, original_data, modified_data, mode, computation, version);
+}
+
 void plot_multiplication(const std::vector<std::complex<double>>& original_data1, const std::vector<std::complex<double>>& original_data2, const std::vector<std::complex<double>>& modified_data, const std::string& mode, const std::string& computation, int version) {
     int n1 = original_data1.size();
     int n2 = original_data2.size();
@@ -125,7 +150,7 @@ void plot_multiplication(const std::vector<std::complex<double>>& original_data1
     gr3->GetYaxis()->SetTitle("Value");
 
     std::ostringstream oss;
-    oss << "plots/" << mode << "_" << computation << "_V" << version << ".png";
+    oss << "plots/" << mode << "_" << computation << "_V" << versionName(version) << ".png";
     std::string filename = oss.str();
 
     c->SaveAs(filename.c_str());
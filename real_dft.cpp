@@ -0,0 +1,119 @@
+#include <complex>
+#include <vector>
+#include <cmath>
+
+#include "core/fft_plan.h"
+#include "dft_versions.h"
+#include "real_dft.h"
+
+
+/**
+ * @brief Computes the DFT of a real signal (real-to-complex), keeping only the N/2 + 1 non-redundant bins.
+ * 
+ * For even N, the samples are packed as z_n = x_{2n} + i x_{2n+1} and a single complex DFT of
+ * size N/2 is run; the spectra E and O of the even and odd samples are then separated using
+ * E_k = (Z_k + conj(Z_{N/2-k})) / 2 and O_k = (Z_k - conj(Z_{N/2-k})) / 2i, and
+ * X_k = E_k + exp(-2iπk/N) O_k. This halves both the arithmetic and the memory of a complex DFT.
+ * Odd sizes fall back to a full complex DFT.
+ * 
+ * @param data Real input signal of size N.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm used for the half-length transform.
+ * @return The N/2 + 1 bins X_0 .. X_{N/2} (the others are their conjugates: X_{N-k} = conj(X_k)).
+ */
+template <typename T>
+std::vector<std::complex<T>> realDFT(const std::vector<T>& data, bool parallel, int version) {
+    using complex = std::complex<T>;
+    int N = data.size();
+    std::vector<complex> spectrum(N / 2 + 1);
+    if (N == 0) {
+        return spectrum;
+    }
+
+    if (N % 2 != 0 || N < 2) {
+        std::vector<complex> full(data.begin(), data.end());
+        forwardDFT(full, parallel, resolveVersion(N, parallel, version));
+        for (int k = 0; k <= N / 2; k++) {
+            spectrum[k] = full[k];
+        }
+        return spectrum;
+    }
+
+    int half = N / 2;
+    std::vector<complex> z(half);
+    for (int n = 0; n < half; n++) {
+        z[n] = complex(data[2 * n], data[2 * n + 1]);
+    }
+
+    forwardDFT(z, parallel, resolveVersion(half, parallel, version));
+
+    const std::vector<complex>& twiddle = getPackTwiddles<T>(N);
+    for (int k = 0; k <= half; k++) {
+        complex Zk = z[k % half];
+        complex Zc = std::conj(z[(half - k) % half]);
+        complex even = (Zk + Zc) * T(0.5);
+        complex odd = (Zk - Zc) * complex(0, T(-0.5));
+        spectrum[k] = even + twiddle[k] * odd;
+    }
+
+    return spectrum;
+}
+
+
+/**
+ * @brief Computes the inverse DFT of a Hermitian spectrum (complex-to-real).
+ * 
+ * Reverses realDFT: E_k and O_k are rebuilt from X_k and conj(X_{N/2-k}), packed as
+ * Z_k = E_k + i O_k, and one inverse complex DFT of size N/2 gives the even samples in the real
+ * parts and the odd samples in the imaginary parts.
+ * 
+ * @param spectrum The N/2 + 1 bins X_0 .. X_{N/2}.
+ * @param N Size of the real signal.
+ * @param parallel Boolean indicating whether to use parallel computation.
+ * @param version Version of the DFT algorithm used for the half-length transform.
+ * @return The real signal of size N.
+ */
+template <typename T>
+std::vector<T> invRealDFT(const std::vector<std::complex<T>>& spectrum, int N, bool parallel, int version) {
+    using complex = std::complex<T>;
+    std::vector<T> data(N);
+
+    if (N % 2 != 0 || N < 2) {
+        std::vector<complex> full(N);
+        for (int k = 0; k < N; k++) {
+            full[k] = (k <= N / 2) ? spectrum[k] : std::conj(spectrum[N - k]);
+        }
+        inverseDFT(full, parallel, resolveVersion(N, parallel, version));
+        for (int n = 0; n < N; n++) {
+            data[n] = full[n].real();
+        }
+        return data;
+    }
+
+    int half = N / 2;
+    std::vector<complex> z(half);
+
+    const std::vector<complex>& twiddle = getPackTwiddles<T>(N);
+    for (int k = 0; k < half; k++) {
+        complex Xk = spectrum[k];
+        complex Xc = std::conj(spectrum[half - k]);
+        complex even = (Xk + Xc) * T(0.5);
+        complex odd = (Xk - Xc) * T(0.5) * std::conj(twiddle[k]);
+        z[k] = even + complex(0, 1) * odd;
+    }
+
+    inverseDFT(z, parallel, resolveVersion(half, parallel, version));
+
+    for (int n = 0; n < half; n++) {
+        data[2 * n] = z[n].real();
+        data[2 * n + 1] = z[n].imag();
+    }
+
+    return data;
+}
+
+
+template std::vector<std::complex<float>> realDFT<float>(const std::vector<float>& data, bool parallel, int version);
+template std::vector<std::complex<double>> realDFT<double>(const std::vector<double>& data, bool parallel, int version);
+template std::vector<float> invRealDFT<float>(const std::vector<std::complex<float>>& spectrum, int N, bool parallel, int version);
+template std::vector<double> invRealDFT<double>(const std::vector<std::complex<double>>& spectrum, int N, bool parallel, int version);
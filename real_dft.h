@@ -0,0 +1,13 @@
+#ifndef REAL_DFT_H
+#define REAL_DFT_H
+
+#include <complex>
+#include <vector>
+
+// Instantiated for float and double
+template <typename T>
+std::vector<std::complex<T>> realDFT(const std::vector<T>& data, bool parallel, int version);
+template <typename T>
+std::vector<T> invRealDFT(const std::vector<std::complex<T>>& spectrum, int N, bool parallel, int version);
+
+#endif
@@ -4,7 +4,10 @@
 #include <complex>
 #include <vector>
 
-void DFT_V1(std::vector<std::complex<double>>& data, int N);
-void invDFT_V1(std::vector<std::complex<double>>& data);
+// Instantiated for float and double
+template <typename T>
+void DFT_V1(std::vector<std::complex<T>>& data, int N);
+template <typename T>
+void invDFT_V1(std::vector<std::complex<T>>& data);
 
 #endif
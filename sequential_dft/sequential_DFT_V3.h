@@ -0,0 +1,13 @@
+#ifndef SEQUENTIAL_DFT_V3_H
+#define SEQUENTIAL_DFT_V3_H
+
+#include <complex>
+#include <vector>
+
+// Instantiated for float and double
+template <typename T>
+void DFT_V3(std::vector<std::complex<T>>& data, int N);
+template <typename T>
+void invDFT_V3(std::vector<std::complex<T>>& data);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef SEQUENTIAL_DFT_BLUESTEIN_H
+#define SEQUENTIAL_DFT_BLUESTEIN_H
+
+#include <complex>
+#include <vector>
+
+// Mixed-radix transforms whose largest prime factor exceeds this go through Bluestein instead
+const int BLUESTEIN_MIN_RADIX = 64;
+
+void bluestein(std::vector<std::complex<double>>& data, bool parallel);
+void DFT_bluestein(std::vector<std::complex<double>>& data, int N);
+void invDFT_bluestein(std::vector<std::complex<double>>& data);
+void clearBluesteinCache();
+
+#endif
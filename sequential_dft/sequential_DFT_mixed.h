@@ -0,0 +1,14 @@
+#ifndef SEQUENTIAL_DFT_MIXED_H
+#define SEQUENTIAL_DFT_MIXED_H
+
+#include <complex>
+#include <vector>
+
+std::vector<int> mixedRadixFactors(int N);
+int largestRadix(const std::vector<int>& factors);
+void mixed_butterfly(std::complex<double>* out, int u, int fstride, int m, int radix, const std::complex<double>* twiddle, int N);
+void mixed_work(std::complex<double>* out, const std::complex<double>* in, int fstride, const int* factors, const std::complex<double>* twiddle, int N);
+void DFT_mixed(std::vector<std::complex<double>>& data, int N);
+void invDFT_mixed(std::vector<std::complex<double>>& data);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef SEQUENTIAL_DFT_RADIX_H
+#define SEQUENTIAL_DFT_RADIX_H
+
+#include <complex>
+#include <vector>
+
+#include "../core/fft_plan.h"
+
+// Instantiated for float and double
+template <typename T>
+void DFT_radix(std::vector<std::complex<T>>& data, int N, FFTAlgorithm algorithm);
+template <typename T>
+void invDFT_radix(std::vector<std::complex<T>>& data, FFTAlgorithm algorithm);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef SEQUENTIAL_DFT_SIMD_H
+#define SEQUENTIAL_DFT_SIMD_H
+
+#include <complex>
+#include <vector>
+
+void DFT_simd(std::vector<std::complex<double>>& data, int N);
+void invDFT_simd(std::vector<std::complex<double>>& data);
+
+#endif
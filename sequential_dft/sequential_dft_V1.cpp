@@ -10,19 +10,22 @@
  * 
  * This first version computes the DFT using the basic definition.
  * 
+ * The roots of unity are evaluated in double and rounded to T.
+ * 
  * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
  * @param N Size of the input vector.
  */
-void DFT_V1(std::vector<std::complex<double>>& data, int N) {
-	std::vector<std::complex<double>> output(N);
+template <typename T>
+void DFT_V1(std::vector<std::complex<T>>& data, int N) {
+	std::vector<std::complex<T>> output(N);
 	for (int i = 0; i < N; ++i) {
-    output[i] = std::complex<double>(0, 0);
+    output[i] = std::complex<T>(0, 0);
 			}
 
 	 for (int k = 0; k < N; ++k) {
         for (int n = 0; n < N; ++n) {
         
-            output[k] += data[n] * std::polar(1.0,  - 2 * M_PI * k*n / N) ;
+            output[k] += data[n] * std::complex<T>(std::polar(1.0,  - 2 * M_PI * k*n / N));
         }
     }
 	
@@ -37,19 +40,26 @@ void DFT_V1(std::vector<std::complex<double>>& data, int N) {
  * 
  * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
  */
-void invDFT_V1(std::vector<std::complex<double>>& data ) {
+template <typename T>
+void invDFT_V1(std::vector<std::complex<T>>& data ) {
 	int N= data.size();
-	std::vector<std::complex<double>> output(N);
+	std::vector<std::complex<T>> output(N);
 		for (int i = 0; i < N; ++i) {
-    	output[i] = std::complex<double>(0, 0);
+    	output[i] = std::complex<T>(0, 0);
 			}
 
 	 for (int k = 0; k < N; ++k) {
         for (int n = 0; n < N; ++n) {
-            output[k] += data[n] * std::polar(1.0,   2 * M_PI * k*n / N) ;
+            output[k] += data[n] * std::complex<T>(std::polar(1.0,   2 * M_PI * k*n / N));
         }
-		output[k] = output[k] /(1.0 * N);
+		output[k] = output[k] / T(N);
     }
 
 	data = output;  
 }
+
+
+template void DFT_V1<float>(std::vector<std::complex<float>>& data, int N);
+template void DFT_V1<double>(std::vector<std::complex<double>>& data, int N);
+template void invDFT_V1<float>(std::vector<std::complex<float>>& data);
+template void invDFT_V1<double>(std::vector<std::complex<double>>& data);
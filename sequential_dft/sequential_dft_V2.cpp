@@ -2,19 +2,20 @@
 #include <vector>
 #include <cmath>
 
-#include "sequential_DFT_V1.h"
+#include "sequential_DFT_V2.h"
 
 
 // Discrete Fourier Transform using Cooley Tukey algorithm
 // This first version computes the "twiddle factors / Nth roots of unity" inside the function
 
 
-void DFT_V2(std::vector<std::complex<double>>& data, int N) {
+template <typename T>
+void DFT_V2(std::vector<std::complex<T>>& data, int N) {
     if (N <= 1) {
 		return;}
 
-	std::vector<std::complex<double>> odd(N / 2);
-    std::vector<std::complex<double>> even(N / 2);
+	std::vector<std::complex<T>> odd(N / 2);
+    std::vector<std::complex<T>> even(N / 2);
 
 	for (int i = 0; i < N / 2; i++) {
 		even[i] = data[i*2];
@@ -25,7 +26,7 @@ void DFT_V2(std::vector<std::complex<double>>& data, int N) {
 	DFT_V2(odd, N/2);
 
 	for (int k = 0; k < N / 2; k++) {
-		std::complex<double> t = std::polar(1.0,  - 2 * M_PI * k / N)  * odd[k];
+		std::complex<T> t = std::complex<T>(std::polar(1.0,  - 2 * M_PI * k / N))  * odd[k];
 		data[k] = even[k] + t;
 		data[N / 2 + k] = even[k] - t;
 	}
@@ -34,7 +35,8 @@ void DFT_V2(std::vector<std::complex<double>>& data, int N) {
 
 // data_copy never used
 
-void invDFT_V2(std::vector<std::complex<double>>& data) {
+template <typename T>
+void invDFT_V2(std::vector<std::complex<T>>& data) {
     int N = data.size() ;
 
     for (int i=0; i < N; i++){
@@ -45,8 +47,13 @@ void invDFT_V2(std::vector<std::complex<double>>& data) {
    
     for (int i = 0; i < N; ++i) {
      
-        data[i] = std::complex<double>(1.0/N)* data[i];
+        data[i] = std::complex<T>(T(1)/N)* std::conj(data[i]);
 
     }
 }
 
+
+template void DFT_V2<float>(std::vector<std::complex<float>>& data, int N);
+template void DFT_V2<double>(std::vector<std::complex<double>>& data, int N);
+template void invDFT_V2<float>(std::vector<std::complex<float>>& data);
+template void invDFT_V2<double>(std::vector<std::complex<double>>& data);
@@ -0,0 +1,40 @@
+#include <complex>
+#include <vector>
+#include <cmath>
+
+#include "sequential_DFT_V3.h"
+#include "../core/fft_plan.h"
+
+
+/**
+ * @brief Performs the Discrete Fourier Transform (DFT) on a given input vector using an iterative radix-2 Cooley-Tukey algorithm.
+ *
+ * Unlike DFT_V2, this version works in place on the caller's buffer: one bit-reversal pass followed by
+ * log2(N) butterfly stages. The permutation and twiddle tables come from the cached plan for N, so
+ * once the plan exists no vector is allocated during the transform.
+ *
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param N Size of the input vector (must be a power of 2).
+ */
+template <typename T>
+void DFT_V3(std::vector<std::complex<T>>& data, int N) {
+    executePlan(getPlan<T>(N, false, 1), data);
+}
+
+
+/**
+ * @brief Performs the Inverse Discrete Fourier Transform (IDFT) on a given input vector using the iterative radix-2 algorithm.
+ *
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ */
+template <typename T>
+void invDFT_V3(std::vector<std::complex<T>>& data) {
+    int N = data.size();
+    executePlan(getPlan<T>(N, true, 1), data);
+}
+
+
+template void DFT_V3<float>(std::vector<std::complex<float>>& data, int N);
+template void DFT_V3<double>(std::vector<std::complex<double>>& data, int N);
+template void invDFT_V3<float>(std::vector<std::complex<float>>& data);
+template void invDFT_V3<double>(std::vector<std::complex<double>>& data);
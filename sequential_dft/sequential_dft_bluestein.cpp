@@ -0,0 +1,150 @@
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "sequential_DFT_bluestein.h"
+#include "sequential_DFT_V3.h"
+#include "../parallel_dft/parallel_DFT_V2.h"
+
+using complex = std::complex<double>;
+
+
+/**
+ * @brief Chirp tables of a Bluestein transform of size N, computed once per N.
+ * 
+ * chirp[n] = exp(-iπn²/N) for n < N, and spectrum is the forward DFT (size M, a power of 2
+ * >= 2N - 1) of the conjugated chirp wrapped around both ends of the buffer.
+ */
+struct BluesteinChirp {
+    int N;
+    int M;
+    std::vector<complex> chirp;
+    std::vector<complex> spectrum;
+};
+
+static std::map<int, std::unique_ptr<BluesteinChirp>> chirp_cache;
+static std::mutex chirp_cache_mutex;
+
+
+static const BluesteinChirp& getChirp(int N) {
+    std::lock_guard<std::mutex> lock(chirp_cache_mutex);
+
+    auto it = chirp_cache.find(N);
+    if (it != chirp_cache.end()) {
+        return *it->second;
+    }
+
+    auto tables = std::make_unique<BluesteinChirp>();
+    tables->N = N;
+    tables->M = 1;
+    while (tables->M < 2 * N - 1) {
+        tables->M <<= 1;
+    }
+
+    tables->chirp.resize(N);
+    for (long long n = 0; n < N; n++) {
+        // n² is reduced modulo 2N so that the angle stays small and accurate
+        long long n2 = (n * n) % (2LL * N);
+        tables->chirp[n] = std::polar(1.0, - M_PI * n2 / N);
+    }
+
+    tables->spectrum.assign(tables->M, complex(0, 0));
+    tables->spectrum[0] = std::conj(tables->chirp[0]);
+    for (int n = 1; n < N; n++) {
+        tables->spectrum[n] = std::conj(tables->chirp[n]);
+        tables->spectrum[tables->M - n] = std::conj(tables->chirp[n]);
+    }
+    DFT_V3(tables->spectrum, tables->M);
+
+    return *chirp_cache.emplace(N, std::move(tables)).first->second;
+}
+
+
+/**
+ * @brief Computes a DFT of any size with Bluestein's algorithm (chirp-z transform).
+ * 
+ * Using nk = (n² + k² - (k-n)²) / 2, the DFT becomes a convolution with the chirp exp(iπn²/N),
+ * computed with power-of-2 FFTs of size M >= 2N - 1. Since the chirp spectrum is cached per N,
+ * each call costs one forward and one inverse FFT of size M.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param parallel Boolean indicating whether to run the power-of-2 FFTs with the parallel version 2.
+ */
+void bluestein(std::vector<complex>& data, bool parallel) {
+    int N = data.size();
+    if (N <= 1) {
+        return;
+    }
+
+    const BluesteinChirp& tables = getChirp(N);
+    int M = tables.M;
+
+    thread_local std::vector<complex> work;
+    work.assign(M, complex(0, 0));
+    for (int n = 0; n < N; n++) {
+        work[n] = data[n] * tables.chirp[n];
+    }
+
+    if (parallel) {
+        DFT_parallel_V2(work);
+    } else {
+        DFT_V3(work, M);
+    }
+
+    for (int k = 0; k < M; k++) {
+        work[k] *= tables.spectrum[k];
+    }
+
+    if (parallel) {
+        invDFT_parallel_V2(work);
+    } else {
+        invDFT_V3(work);
+    }
+
+    for (int k = 0; k < N; k++) {
+        data[k] = work[k] * tables.chirp[k];
+    }
+}
+
+
+/**
+ * @brief Performs the Discrete Fourier Transform (DFT) on a given input vector of any size using Bluestein's algorithm.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param N Size of the input vector.
+ */
+void DFT_bluestein(std::vector<complex>& data, int N) {
+    bluestein(data, false);
+}
+
+
+/**
+ * @brief Performs the Inverse Discrete Fourier Transform (IDFT) on a given input vector of any size using Bluestein's algorithm.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ */
+void invDFT_bluestein(std::vector<complex>& data) {
+    int N = data.size();
+
+    for (int i = 0; i < N; i++) {
+        data[i] = std::conj(data[i]);
+    }
+
+    bluestein(data, false);
+
+    for (int i = 0; i < N; i++) {
+        data[i] = std::conj(data[i]) / (1.0 * N);
+    }
+}
+
+
+/**
+ * @brief Frees every cached chirp table.
+ */
+void clearBluesteinCache() {
+    std::lock_guard<std::mutex> lock(chirp_cache_mutex);
+    chirp_cache.clear();
+}
@@ -0,0 +1,248 @@
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "sequential_DFT_mixed.h"
+#include "sequential_DFT_bluestein.h"
+#include "../core/fft_plan.h"
+
+using complex = std::complex<double>;
+
+
+/**
+ * @brief Splits N into the radices used by the mixed-radix FFT.
+ * 
+ * Radix 4 is taken first, then 2, 3, 5 and 7; any remaining prime factor is kept as a
+ * (generic) radix of its own. The result is stored as pairs (radix, m) where m is the product
+ * of the radices that follow, e.g. N = 60 gives {4, 15, 3, 5, 5, 1}.
+ * 
+ * @param N Size of the transform.
+ * @return The flattened (radix, m) pairs.
+ */
+std::vector<int> mixedRadixFactors(int N) {
+    std::vector<int> factors;
+    int remaining = N;
+
+    for (int radix : {4, 2, 3, 5, 7}) {
+        while (remaining % radix == 0) {
+            remaining /= radix;
+            factors.push_back(radix);
+            factors.push_back(remaining);
+        }
+    }
+
+    for (int radix = 11; remaining > 1; radix += 2) {
+        if (radix * radix > remaining) {
+            radix = remaining;
+        }
+        while (remaining % radix == 0) {
+            remaining /= radix;
+            factors.push_back(radix);
+            factors.push_back(remaining);
+        }
+    }
+
+    return factors;
+}
+
+
+/**
+ * @brief Returns the largest radix of a factorization returned by mixedRadixFactors.
+ */
+int largestRadix(const std::vector<int>& factors) {
+    int largest = 1;
+    for (size_t i = 0; i < factors.size(); i += 2) {
+        largest = std::max(largest, factors[i]);
+    }
+    return largest;
+}
+
+
+/**
+ * @brief Odd-radix butterfly using the symmetry between outputs k and radix - k.
+ * 
+ * With a_q = x_q + x_{radix-q} and b_q = x_q - x_{radix-q}, output k is
+ * x_0 + sum a_q cos(2πqk/radix) - i sum b_q sin(2πqk/radix), and output radix - k is its mirror,
+ * which halves the multiplications of a direct radix-point DFT.
+ * 
+ * @param x Scratch array of radix values (already multiplied by their twiddles).
+ */
+static inline void odd_kernel(complex* out, int u, int m, int radix, const complex* twiddle, int N, complex* x) {
+    int half = radix / 2;
+    int step = N / radix;
+
+    complex sum = x[0];
+    for (int q = 1; q <= half; q++) {
+        sum += x[q] + x[radix - q];
+    }
+    out[u] = sum;
+
+    for (int k = 1; k <= half; k++) {
+        complex re = x[0];
+        complex im = 0;
+        for (int q = 1; q <= half; q++) {
+            // twiddle[j * N / radix] = cos(2πj/radix) - i sin(2πj/radix)
+            const complex& w = twiddle[((q * k) % radix) * step];
+            re += (x[q] + x[radix - q]) * w.real();
+            im -= (x[q] - x[radix - q]) * w.imag();
+        }
+        complex i_im(-im.imag(), im.real());
+        out[u + k * m] = re - i_im;
+        out[u + (radix - k) * m] = re + i_im;
+    }
+}
+
+
+template <int R>
+static inline void butterfly_odd(complex* out, int u, int fstride, int m, const complex* twiddle, int N) {
+    complex x[R];
+    x[0] = out[u];
+    for (int q = 1; q < R; q++) {
+        x[q] = out[u + q * m] * twiddle[q * u * fstride];
+    }
+    odd_kernel(out, u, m, R, twiddle, N, x);
+}
+
+
+/**
+ * @brief Applies one radix butterfly of the mixed-radix FFT.
+ * 
+ * The radix inputs out[u + q*m] (q < radix) are multiplied by their twiddles and replaced by
+ * their radix-point DFT.
+ * 
+ * @param out Buffer holding the radix sub-transforms of length m, one after the other.
+ * @param u Index of the butterfly inside the sub-transforms (0 <= u < m).
+ * @param fstride Twiddle stride: N / (radix * m).
+ * @param m Length of the sub-transforms.
+ * @param radix Radix of this stage.
+ * @param twiddle Twiddle table of the full transform (twiddle[k] = exp(-2iπk/N)).
+ * @param N Size of the full transform.
+ */
+void mixed_butterfly(complex* out, int u, int fstride, int m, int radix, const complex* twiddle, int N) {
+    switch (radix) {
+        case 2: {
+            complex t = out[u + m] * twiddle[u * fstride];
+            out[u + m] = out[u] - t;
+            out[u] += t;
+            break;
+        }
+        case 4: {
+            complex x0 = out[u];
+            complex x1 = out[u + m] * twiddle[u * fstride];
+            complex x2 = out[u + 2 * m] * twiddle[2 * u * fstride];
+            complex x3 = out[u + 3 * m] * twiddle[3 * u * fstride];
+            complex a0 = x0 + x2, a1 = x0 - x2;
+            complex b0 = x1 + x3, b1 = x1 - x3;
+            complex i_b1(-b1.imag(), b1.real());
+            out[u] = a0 + b0;
+            out[u + m] = a1 - i_b1;
+            out[u + 2 * m] = a0 - b0;
+            out[u + 3 * m] = a1 + i_b1;
+            break;
+        }
+        case 3:
+            butterfly_odd<3>(out, u, fstride, m, twiddle, N);
+            break;
+        case 5:
+            butterfly_odd<5>(out, u, fstride, m, twiddle, N);
+            break;
+        case 7:
+            butterfly_odd<7>(out, u, fstride, m, twiddle, N);
+            break;
+        default: {
+            // Generic fallback for larger prime radices
+            thread_local std::vector<complex> x;
+            x.resize(radix);
+            x[0] = out[u];
+            for (int q = 1; q < radix; q++) {
+                x[q] = out[u + q * m] * twiddle[(long long) q * u * fstride % N];
+            }
+            odd_kernel(out, u, m, radix, twiddle, N, x.data());
+            break;
+        }
+    }
+}
+
+
+/**
+ * @brief Recursive decimation-in-time step of the mixed-radix FFT (out of place).
+ * 
+ * Transforms the radix * m values in[0], in[fstride], in[2*fstride], ... into out[0 .. radix*m).
+ * 
+ * @param out Output buffer.
+ * @param in Input buffer (must not overlap out).
+ * @param fstride Distance between consecutive inputs of this sub-transform.
+ * @param factors Remaining (radix, m) pairs, see mixedRadixFactors.
+ * @param twiddle Twiddle table of the full transform.
+ * @param N Size of the full transform.
+ */
+void mixed_work(complex* out, const complex* in, int fstride, const int* factors, const complex* twiddle, int N) {
+    int radix = factors[0];
+    int m = factors[1];
+
+    if (m == 1) {
+        for (int j = 0; j < radix; j++) {
+            out[j] = in[j * fstride];
+        }
+    } else {
+        for (int j = 0; j < radix; j++) {
+            mixed_work(out + j * m, in + j * fstride, fstride * radix, factors + 2, twiddle, N);
+        }
+    }
+
+    for (int u = 0; u < m; u++) {
+        mixed_butterfly(out, u, fstride, m, radix, twiddle, N);
+    }
+}
+
+
+/**
+ * @brief Performs the Discrete Fourier Transform (DFT) on a given input vector of any size using a mixed-radix Cooley-Tukey algorithm.
+ * 
+ * Unlike the radix-2 versions, N does not have to be a power of 2: it is split into radices
+ * 4, 2, 3, 5 and 7, and any other prime factor goes through a generic odd-radix butterfly.
+ * Sizes with a prime factor above BLUESTEIN_MIN_RADIX are handed to Bluestein's algorithm, whose
+ * cost stays O(N log N) where the generic butterfly would approach O(N²).
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param N Size of the input vector.
+ */
+void DFT_mixed(std::vector<complex>& data, int N) {
+    if (N <= 1) {
+        return;
+    }
+
+    std::vector<int> factors = mixedRadixFactors(N);
+    if (largestRadix(factors) > BLUESTEIN_MIN_RADIX) {
+        bluestein(data, false);
+        return;
+    }
+
+    const FFTPlan& plan = getPlan(N, false, 1);
+
+    thread_local std::vector<complex> input;
+    input.assign(data.begin(), data.begin() + N);
+
+    mixed_work(data.data(), input.data(), 1, factors.data(), plan.twiddle.data(), N);
+}
+
+
+/**
+ * @brief Performs the Inverse Discrete Fourier Transform (IDFT) on a given input vector of any size using the mixed-radix algorithm.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ */
+void invDFT_mixed(std::vector<complex>& data) {
+    int N = data.size();
+
+    for (int i = 0; i < N; i++) {
+        data[i] = std::conj(data[i]);
+    }
+
+    DFT_mixed(data, N);
+
+    for (int i = 0; i < N; i++) {
+        data[i] = std::conj(data[i]) / (1.0 * N);
+    }
+}
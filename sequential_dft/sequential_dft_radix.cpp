@@ -0,0 +1,40 @@
+#include <complex>
+#include <vector>
+
+#include "sequential_DFT_radix.h"
+
+
+/**
+ * @brief Performs the Discrete Fourier Transform (DFT) in place with a higher-radix algorithm.
+ *
+ * Same plan-based engine as DFT_V3, but the butterflies are grouped by 4 (radix-4), by 8 (radix-8)
+ * or follow the split-radix decomposition, which cuts the number of passes over the data and
+ * the number of complex multiplications.
+ *
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param N Size of the input vector (must be a power of 2).
+ * @param algorithm Butterfly algorithm stored in the plan.
+ */
+template <typename T>
+void DFT_radix(std::vector<std::complex<T>>& data, int N, FFTAlgorithm algorithm) {
+    executePlan(getPlan<T>(N, false, 1, algorithm), data);
+}
+
+
+/**
+ * @brief Performs the Inverse Discrete Fourier Transform (IDFT) in place with a higher-radix algorithm.
+ *
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param algorithm Butterfly algorithm stored in the plan.
+ */
+template <typename T>
+void invDFT_radix(std::vector<std::complex<T>>& data, FFTAlgorithm algorithm) {
+    int N = data.size();
+    executePlan(getPlan<T>(N, true, 1, algorithm), data);
+}
+
+
+template void DFT_radix<float>(std::vector<std::complex<float>>& data, int N, FFTAlgorithm algorithm);
+template void DFT_radix<double>(std::vector<std::complex<double>>& data, int N, FFTAlgorithm algorithm);
+template void invDFT_radix<float>(std::vector<std::complex<float>>& data, FFTAlgorithm algorithm);
+template void invDFT_radix<double>(std::vector<std::complex<double>>& data, FFTAlgorithm algorithm);
@@ -0,0 +1,62 @@
+#include <complex>
+#include <vector>
+
+#include "sequential_DFT_simd.h"
+#include "../core/fft_plan.h"
+#include "../core/simd_kernels.h"
+
+
+/**
+ * @brief Runs a plan through the SIMD kernels, converting to and from the split layout.
+ * 
+ * The bit-reversal permutation is folded into the conversion to split real/imaginary arrays, and
+ * the inverse scaling into the conversion back, so the data is only read and written once outside
+ * the butterfly stages.
+ */
+static void executeSplit(const FFTPlan& plan, std::vector<std::complex<double>>& data) {
+    int N = plan.N;
+    if (N <= 1) {
+        return;
+    }
+
+    thread_local std::vector<double> re, im;
+    re.resize(N);
+    im.resize(N);
+
+    for (int i = 0; i < N; i++) {
+        re[plan.bitrev[i]] = data[i].real();
+        im[plan.bitrev[i]] = data[i].imag();
+    }
+
+    fft_split(re.data(), im.data(), N, plan.stage_twiddle_re.data(), plan.stage_twiddle_im.data());
+
+    double scale = plan.inverse ? 1.0 / N : 1.0;
+    for (int i = 0; i < N; i++) {
+        data[i] = std::complex<double>(re[i] * scale, im[i] * scale);
+    }
+}
+
+
+/**
+ * @brief Performs the Discrete Fourier Transform (DFT) on a given input vector using SIMD radix-2 kernels.
+ * 
+ * Same algorithm as DFT_V3, but the butterflies run on a split real/imaginary layout with SSE2,
+ * AVX2 or AVX-512 kernels chosen at runtime from the CPU (see activeSimdLevel).
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ * @param N Size of the input vector (must be a power of 2).
+ */
+void DFT_simd(std::vector<std::complex<double>>& data, int N) {
+    executeSplit(getPlan(N, false, 1), data);
+}
+
+
+/**
+ * @brief Performs the Inverse Discrete Fourier Transform (IDFT) on a given input vector using SIMD radix-2 kernels.
+ * 
+ * @param data Input vector of complex numbers. The transformed data will be stored back in this vector.
+ */
+void invDFT_simd(std::vector<std::complex<double>>& data) {
+    int N = data.size();
+    executeSplit(getPlan(N, true, 1), data);
+}
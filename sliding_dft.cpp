@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <complex>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/fft_plan.h"
+
+#include "dft_versions.h"
+#include "full_dft.h"
+#include "sliding_dft.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_ORANGE "\033[38;5;214m"
+#define COLOR_GREEN "\033[32m"
+
+
+/**
+ * @brief Seeds the tracker with the full DFT of the initial window.
+ *
+ * @param initial_window The first N samples of the stream.
+ * @param parallel Boolean indicating whether the full transforms use parallel computation.
+ * @param version Version of the DFT algorithm used for the full transforms.
+ * @param reanchor_interval Number of updates between two full transforms (0 to never re-anchor).
+ * @param bins Indices of the bins to track, all N bins if empty.
+ */
+SlidingDFT::SlidingDFT(const std::vector<std::complex<double>>& initial_window, bool parallel, int version, int reanchor_interval, const std::vector<int>& bins)
+    : N(initial_window.size()), parallel(parallel), version(resolveVersion(initial_window.size(), parallel, version)),
+      reanchor_interval(reanchor_interval), bins(bins), samples(initial_window) {
+    if (this->bins.empty()) {
+        this->bins.resize(N);
+        for (int k = 0; k < N; k++) {
+            this->bins[k] = k;
+        }
+    }
+
+    // exp(+2iπk/N) is the twiddle table of the inverse plan
+    const std::vector<std::complex<double>>& twiddle = getPlan(N, true, 1).twiddle;
+    rotation.resize(this->bins.size());
+    for (size_t b = 0; b < this->bins.size(); b++) {
+        rotation[b] = twiddle[this->bins[b]];
+    }
+
+    values.resize(this->bins.size());
+    reanchor();
+    reanchors = 0;
+}
+
+
+/**
+ * @brief Slides the window by one sample and updates the tracked bins.
+ */
+void SlidingDFT::update(std::complex<double> sample) {
+    std::complex<double> delta = sample - samples[oldest];
+    samples[oldest] = sample;
+    oldest = (oldest + 1) % N;
+
+    for (size_t b = 0; b < values.size(); b++) {
+        values[b] = (values[b] + delta) * rotation[b];
+    }
+
+    since_anchor++;
+    if (reanchor_interval > 0 && since_anchor >= reanchor_interval) {
+        reanchor();
+    }
+}
+
+
+/**
+ * @brief Recomputes the tracked bins with a full transform of the current window.
+ */
+void SlidingDFT::reanchor() {
+    std::vector<std::complex<double>> spectrum = window();
+    forwardDFT(spectrum, parallel, version);
+    for (size_t b = 0; b < bins.size(); b++) {
+        values[b] = spectrum[bins[b]];
+    }
+    since_anchor = 0;
+    reanchors++;
+}
+
+
+int SlidingDFT::size() const {
+    return N;
+}
+
+
+const std::vector<int>& SlidingDFT::trackedBins() const {
+    return bins;
+}
+
+
+/**
+ * @brief Returns the current values of the tracked bins, in the order of trackedBins().
+ */
+const std::vector<std::complex<double>>& SlidingDFT::spectrum() const {
+    return values;
+}
+
+
+/**
+ * @brief Returns the last N samples, oldest first.
+ */
+std::vector<std::complex<double>> SlidingDFT::window() const {
+    std::vector<std::complex<double>> ordered(N);
+    for (int n = 0; n < N; n++) {
+        ordered[n] = samples[(oldest + n) % N];
+    }
+    return ordered;
+}
+
+
+long SlidingDFT::reanchorCount() const {
+    return reanchors;
+}
+
+
+/**
+ * @brief Replays a dataset as a daily stream through a sliding DFT.
+ *
+ * The first half of the data (rounded down to a power of 2) seeds the window and every
+ * following sample is fed to the tracker. Reports the per-sample update latency against the
+ * time of one full transform, and the drift of the tracked spectrum against a fresh DFT.
+ *
+ * @param data Input vector of complex numbers.
+ * @param parallel Boolean indicating whether the full transforms use parallel computation.
+ * @param version Version of the DFT algorithm used for the seed and the re-anchoring.
+ * @param reanchor_interval Number of updates between two full transforms (0 to never re-anchor).
+ */
+void sliding_dft(const std::vector<std::complex<double>>& data, bool parallel, int version, int reanchor_interval) {
+    int N = 1;
+    while (2 * N <= (int)data.size() / 2) {
+        N *= 2;
+    }
+    if ((int)data.size() <= N) {
+        std::cerr << "The dataset is too short for a sliding DFT" << std::endl;
+        return;
+    }
+
+    version = resolveVersion(N, parallel, version);
+    std::string label = versionLabel(parallel, version);
+
+    std::vector<std::complex<double>> initial(data.begin(), data.begin() + N);
+    auto start = std::chrono::high_resolution_clock::now();
+    SlidingDFT tracker(initial, parallel, version, reanchor_interval);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> full_duration = end - start;
+
+    std::vector<double> latencies;
+    latencies.reserve(data.size() - N);
+    for (size_t i = N; i < data.size(); i++) {
+        auto update_start = std::chrono::high_resolution_clock::now();
+        tracker.update(data[i]);
+        auto update_end = std::chrono::high_resolution_clock::now();
+        latencies.push_back(std::chrono::duration<double>(update_end - update_start).count());
+    }
+
+    std::vector<std::complex<double>> reference = tracker.window();
+    forwardDFT(reference, parallel, version);
+    double drift = computeAbsoluteError(reference, tracker.spectrum());
+
+    std::vector<double> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    for (double latency : latencies) {
+        mean += latency;
+    }
+    mean /= latencies.size();
+
+    std::cout << label << "Sliding DFT over a window of " << N << " samples, " << latencies.size() << " updates, " << tracker.reanchorCount() << " re-anchors (every " << reanchor_interval << " samples)" << std::endl;
+    std::cout << label << "Time taken for the full DFT of the window: " << COLOR_GREEN << full_duration.count() << " seconds" << COLOR_RESET << std::endl;
+    std::cout << label << "Per-sample update latency: mean " << COLOR_GREEN << mean << " seconds" << COLOR_RESET
+              << ", median " << sorted[sorted.size() / 2] << ", max " << sorted.back() << " (max includes the re-anchors)" << std::endl;
+    std::cout << label << "Error of the tracked spectrum against a full DFT: " << COLOR_ORANGE << drift << COLOR_RESET << std::endl;
+}
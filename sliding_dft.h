@@ -0,0 +1,47 @@
+#ifndef SLIDING_DFT_H
+#define SLIDING_DFT_H
+
+#include <complex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Keeps the DFT of the last N samples of a stream up to date, one sample at a time.
+ *
+ * Each new sample updates the tracked bins in O(1) per bin with the sliding DFT recurrence
+ * X_k <- (X_k - x_oldest + x_new) * exp(2iπk/N). Rounding errors accumulate in this recurrence,
+ * so every reanchor_interval samples the tracked bins are recomputed from the window with a
+ * full transform of the chosen mode and version.
+ */
+class SlidingDFT {
+public:
+    SlidingDFT(const std::vector<std::complex<double>>& initial_window, bool parallel, int version, int reanchor_interval, const std::vector<int>& bins = {});
+
+    void update(std::complex<double> sample);
+    void reanchor();
+
+    int size() const;
+    const std::vector<int>& trackedBins() const;
+    const std::vector<std::complex<double>>& spectrum() const;
+    std::vector<std::complex<double>> window() const;
+    long reanchorCount() const;
+
+private:
+    int N;
+    bool parallel;
+    int version;
+    int reanchor_interval;
+
+    std::vector<int> bins;
+    std::vector<std::complex<double>> rotation;
+    std::vector<std::complex<double>> values;
+
+    std::vector<std::complex<double>> samples;
+    int oldest = 0;
+    long since_anchor = 0;
+    long reanchors = 0;
+};
+
+void sliding_dft(const std::vector<std::complex<double>>& data, bool parallel, int version, int reanchor_interval);
+
+#endif
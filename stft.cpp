@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <complex>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/thread_pool.h"
+
+#include "dft_versions.h"
+#include "stft.h"
+
+#define COLOR_RESET "\033[0m"
+#define COLOR_ORANGE "\033[38;5;214m"
+#define COLOR_GREEN "\033[32m"
+
+// Capacity of the ring buffer between the producer and the STFT, in samples
+const size_t STFT_RING_CAPACITY = 4096;
+
+// Number of samples the producer pushes at a time
+const size_t STFT_PRODUCER_CHUNK = 64;
+
+
+bool parseWindow(const std::string& name, WindowType& window) {
+    if (name == "rectangular") {
+        window = WindowType::Rectangular;
+    } else if (name == "hann") {
+        window = WindowType::Hann;
+    } else if (name == "hamming") {
+        window = WindowType::Hamming;
+    } else if (name == "blackman") {
+        window = WindowType::Blackman;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+
+const char* windowName(WindowType window) {
+    switch (window) {
+        case WindowType::Rectangular:
+            return "rectangular";
+        case WindowType::Hamming:
+            return "hamming";
+        case WindowType::Blackman:
+            return "blackman";
+        default:
+            return "hann";
+    }
+}
+
+
+/**
+ * @brief Returns the coefficients of a periodic window of the given length.
+ */
+std::vector<double> makeWindow(WindowType window, int length) {
+    std::vector<double> coefficients(length, 1.0);
+    for (int n = 0; n < length; n++) {
+        double phase = 2 * M_PI * n / length;
+        switch (window) {
+            case WindowType::Hann:
+                coefficients[n] = 0.5 - 0.5 * std::cos(phase);
+                break;
+            case WindowType::Hamming:
+                coefficients[n] = 0.54 - 0.46 * std::cos(phase);
+                break;
+            case WindowType::Blackman:
+                coefficients[n] = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2 * phase);
+                break;
+            default:
+                break;
+        }
+    }
+    return coefficients;
+}
+
+
+StreamingSTFT::StreamingSTFT(const STFTConfig& config, bool parallel, int version, FrameCallback on_frame)
+    : config(config), parallel(parallel), version(version), on_frame(std::move(on_frame)) {
+    if (this->config.frames_per_batch <= 0) {
+        this->config.frames_per_batch = parallel ? 4 * getThreadPool().size() : 1;
+    }
+    window = makeWindow(config.window, config.fft_length);
+    history.assign(config.fft_length, 0.0);
+    batch.resize((size_t)this->config.frames_per_batch * config.fft_length);
+    bins.resize(config.fft_length / 2 + 1);
+}
+
+
+/**
+ * @brief Feeds samples to the transform; every hop samples (once fft_length samples were seen)
+ * a windowed frame is queued, and a full batch of frames is transformed and emitted.
+ */
+void StreamingSTFT::push(const double* samples, size_t count) {
+    int N = config.fft_length;
+
+    for (size_t s = 0; s < count; s++) {
+        history[samples_seen % N] = samples[s];
+        samples_seen++;
+
+        if (samples_seen < N || (samples_seen - N) % config.hop != 0) {
+            continue;
+        }
+
+        // history holds the last N samples, the oldest one at samples_seen % N
+        std::complex<double>* frame = batch.data() + (size_t)batch_count * N;
+        int oldest = samples_seen % N;
+        for (int n = 0; n < N; n++) {
+            frame[n] = std::complex<double>(history[(oldest + n) % N] * window[n], 0.0);
+        }
+        batch_count++;
+
+        if (batch_count == config.frames_per_batch) {
+            transformBatch();
+        }
+    }
+}
+
+
+/**
+ * @brief Reads samples from a ring buffer until its producer closes it, then flushes the last frames.
+ */
+void StreamingSTFT::consume(RingBuffer<double>& input) {
+    std::vector<double> chunk(STFT_PRODUCER_CHUNK);
+    while (true) {
+        size_t n = input.pop(chunk.data(), chunk.size());
+        if (n > 0) {
+            push(chunk.data(), n);
+        } else if (input.finished()) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    flush();
+}
+
+
+/**
+ * @brief Transforms and emits the frames queued so far.
+ */
+void StreamingSTFT::flush() {
+    if (batch_count > 0) {
+        transformBatch();
+    }
+}
+
+
+/**
+ * @brief Transforms the queued frames with the selected version.
+ *
+ * In parallel mode the frames are shared out over the thread pool; inside a pool task the
+ * parallel version runs on the calling thread, so each frame uses the selected engine without
+ * nesting teams.
+ */
+void StreamingSTFT::transformBatch() {
+    int N = config.fft_length;
+
+    auto transformFrames = [&](int first, int last) {
+        thread_local std::vector<std::complex<double>> frame;
+        frame.resize(N);
+        for (int f = first; f < last; f++) {
+            std::copy(batch.begin() + (size_t)f * N, batch.begin() + (size_t)(f + 1) * N, frame.begin());
+            forwardDFT(frame, parallel, version);
+            std::copy(frame.begin(), frame.end(), batch.begin() + (size_t)f * N);
+        }
+    };
+
+    if (parallel) {
+        getThreadPool().parallel_for(0, batch_count, transformFrames);
+    } else {
+        transformFrames(0, batch_count);
+    }
+
+    for (int f = 0; f < batch_count; f++) {
+        std::copy(batch.begin() + (size_t)f * N, batch.begin() + (size_t)f * N + bins.size(), bins.begin());
+        on_frame(next_frame++, bins);
+    }
+    batch_count = 0;
+}
+
+
+long StreamingSTFT::framesEmitted() const {
+    return next_frame;
+}
+
+
+/**
+ * @brief Bytes held by the transform (window, sample history, frame batch and output bins).
+ */
+size_t StreamingSTFT::memoryFootprint() const {
+    return (window.size() + history.size()) * sizeof(double) + (batch.size() + bins.size()) * sizeof(std::complex<double>);
+}
+
+
+/**
+ * @brief Streams a signal through the STFT and writes the spectrogram to plots/.
+ *
+ * A producer thread pushes the samples into a lock-free ring buffer in small chunks, as a live
+ * source would, while the calling thread consumes them. Each frame is written to the CSV file
+ * as soon as it is emitted (one line per frame: index, first sample, magnitudes of the bins),
+ * so nothing grows with the length of the stream.
+ *
+ * @param samples Signal to stream.
+ * @param config FFT length, hop size and window.
+ * @param parallel Boolean indicating whether to transform the frames on the thread pool.
+ * @param version Version of the DFT algorithm used in sequential mode.
+ * @param mode "sequential" or "parallel", used in the output file name.
+ */
+void stft(const std::vector<double>& samples, const STFTConfig& config, bool parallel, int version, const std::string& mode) {
+    if (config.fft_length < 2 || config.hop < 1) {
+        std::cerr << "Invalid STFT parameters: the FFT length must be at least 2 and the hop at least 1" << std::endl;
+        return;
+    }
+
+    version = resolveVersion(config.fft_length, parallel, version);
+    std::string label = versionLabel(parallel, version);
+
+    std::filesystem::create_directories("plots");
+    std::ostringstream oss;
+    oss << "plots/" << mode << "_stft_V" << versionName(version) << ".csv";
+    std::string filename = oss.str();
+    std::ofstream output(filename);
+
+    int dominant_bin = 0;
+    auto on_frame = [&](long frame, const std::vector<std::complex<double>>& bins) {
+        output << frame << "," << frame * config.hop;
+        double largest = -1.0;
+        for (size_t k = 0; k < bins.size(); k++) {
+            double magnitude = std::abs(bins[k]);
+            output << "," << magnitude;
+            if (k > 0 && magnitude > largest) {
+                largest = magnitude;
+                dominant_bin = k;
+            }
+        }
+        output << "\n";
+    };
+
+    StreamingSTFT transform(config, parallel, version, on_frame);
+    RingBuffer<double> ring(STFT_RING_CAPACITY);
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::thread producer([&]() {
+        size_t position = 0;
+        while (position < samples.size()) {
+            size_t count = std::min(STFT_PRODUCER_CHUNK, samples.size() - position);
+            size_t pushed = ring.push(samples.data() + position, count);
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+            position += pushed;
+        }
+        ring.close();
+    });
+
+    transform.consume(ring);
+    producer.join();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    std::cout << label << "STFT of " << samples.size() << " samples (" << windowName(config.window) << " window, FFT length " << config.fft_length << ", hop " << config.hop << "): "
+              << transform.framesEmitted() << " frames written to " << filename << std::endl;
+    std::cout << label << "Time taken for the streaming STFT: " << COLOR_GREEN << duration.count() << " seconds" << COLOR_RESET
+              << " (" << transform.framesEmitted() / duration.count() << " frames per second)" << std::endl;
+    std::cout << label << "Memory held by the stream: " << COLOR_ORANGE << (transform.memoryFootprint() + ring.capacity() * sizeof(double)) / 1024.0 << " KiB" << COLOR_RESET
+              << ", dominant period in the last frame: " << (dominant_bin > 0 ? 1.0 * config.fft_length / dominant_bin : 0.0) << " samples" << std::endl;
+}
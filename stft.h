@@ -0,0 +1,70 @@
+#ifndef STFT_H
+#define STFT_H
+
+#include <complex>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/ring_buffer.h"
+
+enum class WindowType { Rectangular, Hann, Hamming, Blackman };
+
+/**
+ * @brief Parameters of a short-time Fourier transform.
+ *
+ * frames_per_batch frames are collected before being transformed together; 0 means four frames
+ * per thread of the pool.
+ */
+struct STFTConfig {
+    int fft_length = 256;
+    int hop = 64;
+    WindowType window = WindowType::Hann;
+    int frames_per_batch = 0;
+};
+
+bool parseWindow(const std::string& name, WindowType& window);
+const char* windowName(WindowType window);
+std::vector<double> makeWindow(WindowType window, int length);
+
+/**
+ * @brief Incremental STFT: consumes samples as they arrive and emits each frame once it is complete.
+ *
+ * Memory stays bounded by the configuration: the last fft_length samples and one batch of
+ * frames are kept, whatever the length of the stream.
+ */
+class StreamingSTFT {
+public:
+    // Receives the frame index and its fft_length / 2 + 1 non-negative frequency bins
+    using FrameCallback = std::function<void(long, const std::vector<std::complex<double>>&)>;
+
+    StreamingSTFT(const STFTConfig& config, bool parallel, int version, FrameCallback on_frame);
+
+    void push(const double* samples, size_t count);
+    void consume(RingBuffer<double>& input);
+    void flush();
+
+    long framesEmitted() const;
+    size_t memoryFootprint() const;
+
+private:
+    void transformBatch();
+
+    STFTConfig config;
+    bool parallel;
+    int version;
+    FrameCallback on_frame;
+
+    std::vector<double> window;
+    std::vector<double> history;
+    long samples_seen = 0;
+
+    std::vector<std::complex<double>> batch;
+    int batch_count = 0;
+    long next_frame = 0;
+    std::vector<std::complex<double>> bins;
+};
+
+void stft(const std::vector<double>& samples, const STFTConfig& config, bool parallel, int version, const std::string& mode);
+
+#endif